@@ -8,6 +8,8 @@
 #include <string.h>
 #include <ctype.h>
 #include <stdbool.h>
+#include "string_search.h"
+#include "aho_corasick.h"
 
 // Check if string is palindrome
 bool isPalindrome(const char *str) {
@@ -80,43 +82,15 @@ void reverseWords(char *str) {
     }
 }
 
-// Naive pattern matching
+// Pattern matching (first occurrence, or -1)
 int patternMatch(const char *text, const char *pattern) {
-    int n = strlen(text);
-    int m = strlen(pattern);
-    
-    for (int i = 0; i <= n - m; i++) {
-        int j;
-        for (j = 0; j < m; j++) {
-            if (text[i + j] != pattern[j]) {
-                break;
-            }
-        }
-        if (j == m) {
-            return i;  // Pattern found at index i
-        }
-    }
-    return -1;  // Pattern not found
+    size_t pos = findSubstring(text, strlen(text), pattern, strlen(pattern));
+    return pos == STRING_NOT_FOUND ? -1 : (int)pos;
 }
 
-// Count all occurrences of pattern in text
+// Count all occurrences of pattern in text, overlapping ones included
 int countOccurrences(const char *text, const char *pattern) {
-    int count = 0;
-    int n = strlen(text);
-    int m = strlen(pattern);
-    
-    for (int i = 0; i <= n - m; i++) {
-        int j;
-        for (j = 0; j < m; j++) {
-            if (text[i + j] != pattern[j]) {
-                break;
-            }
-        }
-        if (j == m) {
-            count++;
-        }
-    }
-    return count;
+    return (int)findAllSubstrings(text, strlen(text), pattern, strlen(pattern), NULL, 0);
 }
 
 // Remove duplicates from string
@@ -231,7 +205,25 @@ int main() {
     printf("   Text: %s\n", text);
     printf("   Pattern: %s\n", pattern);
     printf("   First occurrence at index: %d\n", pos);
-    printf("   Total occurrences: %d\n\n", countOccurrences(text, pattern));
+    printf("   Total occurrences: %d\n", countOccurrences(text, pattern));
+    size_t offsets[8];
+    size_t found = findAllSubstrings(text, strlen(text), pattern, strlen(pattern), offsets, 8);
+    printf("   All offsets:");
+    for (size_t i = 0; i < found && i < 8; i++) printf(" %zu", offsets[i]);
+    printf("\n");
+
+    // Several patterns in one pass instead of one search each
+    const char *keywords[] = { "AABA", "AAC", "BA" };
+    size_t keyword_lengths[] = { 4, 3, 2 };
+    AhoCorasick *automaton = createAhoCorasick(keywords, keyword_lengths, 3);
+    AcMatch matches[16];
+    size_t num_matches = acFindAll(automaton, text, strlen(text), matches, 16);
+    printf("   Keywords AABA, AAC, BA in one pass:");
+    for (size_t i = 0; i < num_matches && i < 16; i++) {
+        printf(" %s@%zu", keywords[matches[i].pattern], matches[i].offset);
+    }
+    printf("\n\n");
+    freeAhoCorasick(automaton);
     
     // Remove duplicates
     printf("5. Remove Duplicates:\n");
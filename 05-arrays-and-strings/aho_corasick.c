@@ -0,0 +1,420 @@
+/*
+ * aho_corasick.c
+ * Aho-Corasick automaton with dense shallow rows and sparse deep edges
+ * Topics: tries, failure links, breadth-first numbering, cache-aware
+ *         table layout, streaming search
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "aho_corasick.h"
+
+#define AC_ROOT 0u
+#define AC_NO_STATE UINT32_MAX
+#define AC_MATCH_FLAG 0x80000000u   // Set in a transition whose target reports
+#define AC_STATE_MASK 0x7fffffffu
+
+#define AC_LANES 4                  // Parts of a buffer scanned side by side (see scanLanes)
+#define AC_LANE_MIN 4096            // Shortest part worth its warm-up
+
+struct AhoCorasick {
+    uint32_t num_states;
+    uint32_t num_dense;             // States 0 .. num_dense-1 have full rows
+
+    // Bytes are mapped to classes first: one per byte used in a pattern,
+    // plus one shared by every other byte
+    unsigned char byte_class[256];
+    uint32_t num_classes;
+
+    // Dense part: num_dense rows of num_classes flagged targets
+    uint32_t *dense;
+
+    // Sparse part, for every state (empty for dense ones): edges
+    // edge_start[s] .. edge_start[s+1]-1, sorted by label
+    uint32_t *edge_start;
+    unsigned char *labels;
+    uint32_t *targets;              // Flagged like the dense rows
+    uint32_t *fail;
+
+    // Patterns ending exactly at s: out_patterns[out_start[s] .. out_start[s+1]-1];
+    // out_link[s] is the next state on the failure chain with any
+    int *out_patterns;
+    uint32_t *out_start;
+    uint32_t *out_link;
+    size_t *pattern_lengths;
+    size_t max_length;              // No state is deeper than this
+};
+
+// ===== Construction =====
+
+// Pointer-linked trie used only while building; children are kept in
+// sibling lists sorted by byte
+typedef struct {
+    uint32_t *first_child;
+    uint32_t *next_sibling;
+    unsigned char *label;
+    uint32_t *depth;
+    int *first_output;              // Linked through next_output
+    int *next_output;
+    uint32_t size;
+} Trie;
+
+static uint32_t findChild(const Trie *trie, uint32_t node, unsigned char c) {
+    for (uint32_t child = trie->first_child[node]; child != AC_NO_STATE;
+         child = trie->next_sibling[child]) {
+        if (trie->label[child] == c) return child;
+        if (trie->label[child] > c) break;
+    }
+    return AC_NO_STATE;
+}
+
+static uint32_t addChild(Trie *trie, uint32_t node, unsigned char c) {
+    uint32_t *link = &trie->first_child[node];
+    while (*link != AC_NO_STATE && trie->label[*link] < c) link = &trie->next_sibling[*link];
+    if (*link != AC_NO_STATE && trie->label[*link] == c) return *link;
+
+    uint32_t child = trie->size++;
+    trie->first_child[child] = AC_NO_STATE;
+    trie->next_sibling[child] = *link;
+    trie->label[child] = c;
+    trie->depth[child] = trie->depth[node] + 1;
+    trie->first_output[child] = -1;
+    *link = child;
+    return child;
+}
+
+static void freeTrie(Trie *trie) {
+    free(trie->first_child);
+    free(trie->next_sibling);
+    free(trie->label);
+    free(trie->depth);
+    free(trie->first_output);
+    free(trie->next_output);
+}
+
+// Lay the trie out in breadth-first order, so that depth never decreases
+// with the state number and every failure link points to a lower number
+static void numberStates(const Trie *trie, uint32_t *order, uint32_t *number) {
+    uint32_t head = 0, tail = 0;
+    order[tail++] = AC_ROOT;
+    while (head < tail) {
+        uint32_t node = order[head++];
+        number[node] = head - 1;
+        for (uint32_t child = trie->first_child[node]; child != AC_NO_STATE;
+             child = trie->next_sibling[child]) {
+            order[tail++] = child;
+        }
+    }
+}
+
+// Whole levels from the root down, while their rows fit in AC_DENSE_BYTES
+static uint32_t countDenseStates(const Trie *trie, const uint32_t *order, uint32_t num_classes) {
+    size_t max_rows = AC_DENSE_BYTES / (num_classes * sizeof(uint32_t));
+    uint32_t dense = 1;
+    while (dense < trie->size) {
+        uint32_t depth = trie->depth[order[dense]];
+        uint32_t level_end = dense;
+        while (level_end < trie->size && trie->depth[order[level_end]] == depth) level_end++;
+        if (level_end > max_rows) break;
+        dense = level_end;
+    }
+    return dense;
+}
+
+static inline uint32_t flagged(const AhoCorasick *ac, uint32_t state) {
+    bool reports = ac->out_start[state + 1] > ac->out_start[state] ||
+                   ac->out_link[state] != AC_NO_STATE;
+    return reports ? state | AC_MATCH_FLAG : state;
+}
+
+AhoCorasick* createAhoCorasick(const char *const *patterns, const size_t *lengths,
+                               size_t num_patterns) {
+    size_t total_length = 0, max_length = 0;
+    for (size_t p = 0; p < num_patterns; p++) {
+        total_length += lengths[p];
+        if (lengths[p] > max_length) max_length = lengths[p];
+    }
+    if (total_length >= AC_STATE_MASK || num_patterns > (size_t)AC_STATE_MASK) return NULL;
+
+    AhoCorasick *ac = (AhoCorasick*)malloc(sizeof(AhoCorasick));
+    ac->max_length = max_length;
+
+    // 1. Byte classes, numbered in byte order so that sorted edges stay
+    //    sorted; the shared class comes last
+    bool used[256] = { false };
+    for (size_t p = 0; p < num_patterns; p++) {
+        for (size_t i = 0; i < lengths[p]; i++) used[(unsigned char)patterns[p][i]] = true;
+    }
+    uint32_t num_used = 0;
+    for (int c = 0; c < 256; c++) {
+        if (used[c]) ac->byte_class[c] = (unsigned char)num_used++;
+    }
+    for (int c = 0; c < 256; c++) {
+        if (!used[c]) ac->byte_class[c] = (unsigned char)num_used;
+    }
+    ac->num_classes = num_used < 256 ? num_used + 1 : 256;
+
+    // 2. Trie of the patterns, over byte classes
+    size_t max_states = total_length + 1;
+    Trie trie;
+    trie.first_child = (uint32_t*)malloc(max_states * sizeof(uint32_t));
+    trie.next_sibling = (uint32_t*)malloc(max_states * sizeof(uint32_t));
+    trie.label = (unsigned char*)malloc(max_states);
+    trie.depth = (uint32_t*)malloc(max_states * sizeof(uint32_t));
+    trie.first_output = (int*)malloc(max_states * sizeof(int));
+    trie.next_output = (int*)malloc((num_patterns > 0 ? num_patterns : 1) * sizeof(int));
+    trie.first_child[AC_ROOT] = AC_NO_STATE;
+    trie.next_sibling[AC_ROOT] = AC_NO_STATE;
+    trie.label[AC_ROOT] = 0;
+    trie.depth[AC_ROOT] = 0;
+    trie.first_output[AC_ROOT] = -1;
+    trie.size = 1;
+
+    for (size_t p = 0; p < num_patterns; p++) {
+        if (lengths[p] == 0) continue;
+        const unsigned char *x = (const unsigned char*)patterns[p];
+        uint32_t node = AC_ROOT;
+        for (size_t i = 0; i < lengths[p]; i++) {
+            node = addChild(&trie, node, ac->byte_class[x[i]]);
+        }
+        trie.next_output[p] = trie.first_output[node];
+        trie.first_output[node] = (int)p;
+    }
+
+    uint32_t n = trie.size;
+    ac->num_states = n;
+
+    // 3. Breadth-first numbering; from here on every array is indexed by
+    //    the new numbers
+    uint32_t *order = (uint32_t*)malloc(n * sizeof(uint32_t));
+    uint32_t *number = (uint32_t*)malloc(n * sizeof(uint32_t));
+    numberStates(&trie, order, number);
+    ac->num_dense = countDenseStates(&trie, order, ac->num_classes);
+
+    // 4. Edges, and patterns ending at each state
+    ac->edge_start = (uint32_t*)malloc((size_t)(n + 1) * sizeof(uint32_t));
+    ac->labels = (unsigned char*)malloc(n);
+    ac->targets = (uint32_t*)malloc(n * sizeof(uint32_t));
+    ac->out_start = (uint32_t*)malloc((size_t)(n + 1) * sizeof(uint32_t));
+    ac->out_patterns = (int*)malloc((num_patterns > 0 ? num_patterns : 1) * sizeof(int));
+    uint32_t num_edges = 0, num_outputs = 0;
+    for (uint32_t s = 0; s < n; s++) {
+        uint32_t node = order[s];
+        ac->edge_start[s] = num_edges;
+        for (uint32_t child = trie.first_child[node]; child != AC_NO_STATE;
+             child = trie.next_sibling[child]) {
+            ac->labels[num_edges] = trie.label[child];
+            ac->targets[num_edges++] = number[child];
+        }
+        ac->out_start[s] = num_outputs;
+        for (int p = trie.first_output[node]; p >= 0; p = trie.next_output[p]) {
+            ac->out_patterns[num_outputs++] = p;
+        }
+    }
+    ac->edge_start[n] = num_edges;
+    ac->out_start[n] = num_outputs;
+
+    // 5. Failure and output links, parents before children
+    ac->fail = (uint32_t*)malloc(n * sizeof(uint32_t));
+    ac->out_link = (uint32_t*)malloc(n * sizeof(uint32_t));
+    ac->fail[AC_ROOT] = AC_ROOT;
+    ac->out_link[AC_ROOT] = AC_NO_STATE;
+    for (uint32_t s = 0; s < n; s++) {
+        for (uint32_t e = ac->edge_start[s]; e < ac->edge_start[s + 1]; e++) {
+            unsigned char c = ac->labels[e];
+            uint32_t child = ac->targets[e];
+            uint32_t f = AC_ROOT;
+            if (s != AC_ROOT) {
+                uint32_t state = ac->fail[s];
+                uint32_t next;
+                while ((next = findChild(&trie, order[state], c)) == AC_NO_STATE &&
+                       state != AC_ROOT) {
+                    state = ac->fail[state];
+                }
+                if (next != AC_NO_STATE) f = number[next];
+            }
+            ac->fail[child] = f;
+            ac->out_link[child] = ac->out_start[f + 1] > ac->out_start[f] ? f : ac->out_link[f];
+        }
+    }
+
+    // 6. Dense rows: real edges, else the row of the failure state,
+    //    which is shallower and so already complete
+    size_t row_size = ac->num_classes;
+    ac->dense = (uint32_t*)malloc((size_t)ac->num_dense * row_size * sizeof(uint32_t));
+    for (uint32_t s = 0; s < ac->num_dense; s++) {
+        uint32_t *row = ac->dense + s * row_size;
+        if (s == AC_ROOT) {
+            for (size_t c = 0; c < row_size; c++) row[c] = AC_ROOT;
+        } else {
+            memcpy(row, ac->dense + ac->fail[s] * row_size, row_size * sizeof(uint32_t));
+        }
+        for (uint32_t e = ac->edge_start[s]; e < ac->edge_start[s + 1]; e++) {
+            row[ac->labels[e]] = flagged(ac, ac->targets[e]);
+        }
+    }
+    for (uint32_t e = 0; e < num_edges; e++) ac->targets[e] = flagged(ac, ac->targets[e]);
+
+    ac->pattern_lengths = (size_t*)malloc((num_patterns > 0 ? num_patterns : 1) * sizeof(size_t));
+    if (num_patterns > 0) memcpy(ac->pattern_lengths, lengths, num_patterns * sizeof(size_t));
+
+    free(order);
+    free(number);
+    freeTrie(&trie);
+    return ac;
+}
+
+void freeAhoCorasick(AhoCorasick *automaton) {
+    if (automaton == NULL) return;
+    free(automaton->dense);
+    free(automaton->edge_start);
+    free(automaton->labels);
+    free(automaton->targets);
+    free(automaton->fail);
+    free(automaton->out_patterns);
+    free(automaton->out_start);
+    free(automaton->out_link);
+    free(automaton->pattern_lengths);
+    free(automaton);
+}
+
+size_t acNumStates(const AhoCorasick *automaton) {
+    return automaton->num_states;
+}
+
+// ===== Matching =====
+
+// Transition out of a sparse state: its own edges, else those of its
+// failure states, until a dense row answers
+static uint32_t sparseStep(const AhoCorasick *ac, uint32_t s, unsigned char c) {
+    do {
+        for (uint32_t e = ac->edge_start[s]; e < ac->edge_start[s + 1]; e++) {
+            if (ac->labels[e] == c) return ac->targets[e];
+            if (ac->labels[e] > c) break;
+        }
+        s = ac->fail[s];
+    } while (s >= ac->num_dense);
+    return ac->dense[s * ac->num_classes + c];
+}
+
+static inline uint32_t step(const AhoCorasick *ac, uint32_t s, unsigned char byte) {
+    unsigned char c = ac->byte_class[byte];
+    if (s < ac->num_dense) return ac->dense[s * ac->num_classes + c];
+    return sparseStep(ac, s, c);
+}
+
+// Every pattern that ends at state s, i.e. at stream offset end
+static bool reportMatches(const AhoCorasick *ac, uint32_t s, size_t end, AcCallback callback,
+                          void *context) {
+    for (; s != AC_NO_STATE; s = ac->out_link[s]) {
+        for (uint32_t i = ac->out_start[s]; i < ac->out_start[s + 1]; i++) {
+            int p = ac->out_patterns[i];
+            if (!callback(context, p, end - ac->pattern_lengths[p])) return false;
+        }
+    }
+    return true;
+}
+
+// State reached after the max_length bytes before y[at], starting from
+// the root: no state is deeper than max_length, so it is exactly the
+// state a scan from the start of the stream would be in
+static uint32_t warmUp(const AhoCorasick *ac, const unsigned char *y, size_t at) {
+    uint32_t s = AC_ROOT;
+    for (size_t i = at - ac->max_length; i < at; i++) s = step(ac, s, y[i]) & AC_STATE_MASK;
+    return s;
+}
+
+// Each step depends on the state left by the previous one, so a single
+// scan runs at the latency of a table load per byte. Four quarters of
+// the buffer are scanned in the same loop instead, which keeps four
+// loads in flight; the later quarters start from warmUp(). The states
+// are separate variables so that they stay in registers.
+static bool scanLanes(const AhoCorasick *ac, uint32_t *state, const unsigned char *y,
+                      size_t lane, size_t base, AcCallback callback, void *context) {
+    const unsigned char *y1 = y + lane, *y2 = y + 2 * lane, *y3 = y + 3 * lane;
+    uint32_t s0 = *state;
+    uint32_t s1 = warmUp(ac, y, lane);
+    uint32_t s2 = warmUp(ac, y, 2 * lane);
+    uint32_t s3 = warmUp(ac, y, 3 * lane);
+
+    for (size_t i = 0; i < lane; i++) {
+        uint32_t n0 = step(ac, s0, y[i]);
+        uint32_t n1 = step(ac, s1, y1[i]);
+        uint32_t n2 = step(ac, s2, y2[i]);
+        uint32_t n3 = step(ac, s3, y3[i]);
+        s0 = n0 & AC_STATE_MASK;
+        s1 = n1 & AC_STATE_MASK;
+        s2 = n2 & AC_STATE_MASK;
+        s3 = n3 & AC_STATE_MASK;
+        if ((n0 | n1 | n2 | n3) & AC_MATCH_FLAG) {
+            size_t end = base + i + 1;
+            if (((n0 & AC_MATCH_FLAG) && !reportMatches(ac, s0, end, callback, context)) ||
+                ((n1 & AC_MATCH_FLAG) && !reportMatches(ac, s1, end + lane, callback, context)) ||
+                ((n2 & AC_MATCH_FLAG) &&
+                 !reportMatches(ac, s2, end + 2 * lane, callback, context)) ||
+                ((n3 & AC_MATCH_FLAG) &&
+                 !reportMatches(ac, s3, end + 3 * lane, callback, context))) {
+                return false;
+            }
+        }
+    }
+    *state = s3;
+    return true;
+}
+
+bool acStreamFeed(AcStream *stream, const char *buffer, size_t length, AcCallback callback,
+                  void *context) {
+    const AhoCorasick *ac = stream->automaton;
+    const unsigned char *y = (const unsigned char*)buffer;
+    size_t base = stream->position;
+    size_t i = 0;
+
+    size_t lane = length / AC_LANES;
+    if (lane >= AC_LANE_MIN && lane >= 4 * ac->max_length) {
+        if (!scanLanes(ac, &stream->state, y, lane, base, callback, context)) return false;
+        i = AC_LANES * lane;
+    }
+
+    uint32_t s = stream->state;
+    for (; i < length; i++) {
+        uint32_t next = step(ac, s, y[i]);
+        s = next & AC_STATE_MASK;
+        if ((next & AC_MATCH_FLAG) && !reportMatches(ac, s, base + i + 1, callback, context)) {
+            return false;
+        }
+    }
+    stream->state = s;
+    stream->position = base + length;
+    return true;
+}
+
+void acStreamInit(AcStream *stream, const AhoCorasick *automaton) {
+    stream->automaton = automaton;
+    stream->state = AC_ROOT;
+    stream->position = 0;
+}
+
+typedef struct {
+    AcMatch *matches;
+    size_t max_matches;
+    size_t count;
+} MatchList;
+
+static bool collectMatch(void *context, int pattern, size_t offset) {
+    MatchList *list = (MatchList*)context;
+    if (list->matches != NULL && list->count < list->max_matches) {
+        list->matches[list->count].pattern = pattern;
+        list->matches[list->count].offset = offset;
+    }
+    list->count++;
+    return true;
+}
+
+size_t acFindAll(const AhoCorasick *automaton, const char *text, size_t text_len,
+                 AcMatch *matches, size_t max_matches) {
+    AcStream stream;
+    MatchList list = { matches, max_matches, 0 };
+    acStreamInit(&stream, automaton);
+    acStreamFeed(&stream, text, text_len, collectMatch, &list);
+    return list.count;
+}
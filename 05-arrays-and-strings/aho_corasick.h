@@ -0,0 +1,99 @@
+/*
+ * aho_corasick.h
+ * Multi-pattern matching with an Aho-Corasick automaton
+ *
+ * All patterns are found in one pass over the text, whatever their
+ * number. The automaton is a trie of the patterns plus failure links
+ * (longest proper suffix of a state that is also a trie path).
+ *
+ * The transition table is split by depth so that the states visited
+ * most often stay in cache:
+ *   - bytes are first mapped to classes: one per byte that occurs in
+ *     some pattern, one for all the others. Keywords made of letters
+ *     need rows of ~30 entries instead of 256
+ *   - the root and the shallowest levels (as many whole levels as fit
+ *     in AC_DENSE_BYTES) get a full row with failure moves already
+ *     resolved: one load per byte
+ *   - deeper states keep only their real edges, sorted by byte, in
+ *     shared flat arrays; a miss follows failure links until it reaches
+ *     a dense state
+ * States are numbered in breadth-first order, and the bit reporting
+ * "some pattern ends here" rides in the transition itself, so the scan
+ * loop touches no other array until there is a match.
+ *
+ * A long buffer is scanned as four interleaved parts, each one started
+ * from the bytes just before it, because a single scan waits for every
+ * table load before it can issue the next.
+ */
+
+#ifndef AHO_CORASICK_H
+#define AHO_CORASICK_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#define AC_DENSE_BYTES (1 << 20)    // Memory for full transition rows
+
+typedef struct AhoCorasick AhoCorasick;
+
+typedef struct {
+    int pattern;                    // Index in the array given at creation
+    size_t offset;                  // Where the match starts in the text/stream
+} AcMatch;
+
+/**
+ * @brief Called for every match; return false to stop the scan
+ */
+typedef bool (*AcCallback)(void *context, int pattern, size_t offset);
+
+/**
+ * @brief Scan position carried from one buffer to the next
+ */
+typedef struct {
+    const AhoCorasick *automaton;
+    uint32_t state;
+    size_t position;                // Bytes consumed so far
+} AcStream;
+
+/**
+ * @brief Build the automaton
+ * @param patterns num_patterns byte strings (not necessarily terminated)
+ * @param lengths Their lengths; empty patterns never match
+ */
+AhoCorasick* createAhoCorasick(const char *const *patterns, const size_t *lengths,
+                               size_t num_patterns);
+
+void freeAhoCorasick(AhoCorasick *automaton);
+
+/**
+ * @brief Number of states (trie nodes) in the automaton
+ */
+size_t acNumStates(const AhoCorasick *automaton);
+
+/**
+ * @brief Every match in one buffer, in no particular order
+ * @param matches Receives the first max_matches matches; may be NULL
+ * @return Total number of matches, which may exceed max_matches
+ */
+size_t acFindAll(const AhoCorasick *automaton, const char *text, size_t text_len,
+                 AcMatch *matches, size_t max_matches);
+
+/**
+ * @brief Start a stream at offset 0
+ */
+void acStreamInit(AcStream *stream, const AhoCorasick *automaton);
+
+/**
+ * @brief Scan the next buffer of the stream
+ *
+ * Matches may start in an earlier buffer; offsets count from the start
+ * of the stream. Buffers need not be kept after the call. Matches are
+ * reported once each, in no particular order within a buffer.
+ * @return false if the callback stopped the scan; the stream cannot be
+ *         fed any further
+ */
+bool acStreamFeed(AcStream *stream, const char *buffer, size_t length, AcCallback callback,
+                  void *context);
+
+#endif /* AHO_CORASICK_H */
@@ -1,4 +1,14 @@
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <time.h>
+#include "sorting.h"
+#include "parallel_sort.h"
+#include "searching.h"
+#include "simd_scan.h"
+#include "selection.h"
 
 // Linear search
 int linearSearch(int arr[], int size, int target) {
@@ -84,7 +94,59 @@ void reverseArray(int arr[], int size) {
     }
 }
 
-int main() {
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// xorshift64: fast reproducible test data
+static inline unsigned long long nextRandom(unsigned long long *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+int compareInts(const void *a, const void *b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+int compareDoubles(const void *a, const void *b) {
+    double x = *(const double*)a, y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+bool isSortedInts(const int *arr, size_t size) {
+    for (size_t i = 1; i < size; i++) {
+        if (arr[i] < arr[i - 1]) return false;
+    }
+    return true;
+}
+
+// Time introSortInt against qsort on one input pattern
+void compareIntSorts(const char *name, const int *input, size_t size) {
+    int *a = (int*)malloc(size * sizeof(int));
+    int *b = (int*)malloc(size * sizeof(int));
+    for (size_t i = 0; i < size; i++) a[i] = b[i] = input[i];
+
+    double start = nowSeconds();
+    introSortInt(a, size);
+    double t_intro = nowSeconds() - start;
+    start = nowSeconds();
+    qsort(b, size, sizeof(int), compareInts);
+    double t_qsort = nowSeconds() - start;
+
+    bool same = isSortedInts(a, size);
+    for (size_t i = 0; i < size && same; i++) same = a[i] == b[i];
+    printf("  %-10s introSort %7.3f s, qsort %7.3f s (%5.1fx)  %s\n", name, t_intro, t_qsort,
+           t_qsort / t_intro, same ? "OK" : "MISMATCH");
+    free(a);
+    free(b);
+}
+
+int main(int argc, char *argv[]) {
     printf("=== Array Algorithms ===\n\n");
     
     int arr[] = {64, 34, 25, 12, 22, 11, 90};
@@ -115,6 +177,14 @@ int main() {
     printf("Binary search for %d: %s at index %d\n", 
            target, index != -1 ? "Found" : "Not found", index);
     
+    // Lower bound: where a key is, or where it would be inserted
+    int lookups[] = {25, 30, 5, 100};
+    size_t positions[4];
+    lowerBoundBatchInt(arr2, size, lookups, 4, positions);
+    printf("Lower bounds (batched):");
+    for (int i = 0; i < 4; i++) printf(" %d->%zu", lookups[i], positions[i]);
+    printf(" (branchless single: 30->%zu)\n", lowerBoundInt(arr2, size, 30));
+    
     // Reverse array
     printf("\nBefore reverse: ");
     printArray(arr2, size);
@@ -122,5 +192,78 @@ int main() {
     printf("After reverse: ");
     printArray(arr2, size);
     
+    // Same answers, several elements per instruction
+    printf("\nSIMD (%s): max %d, search for %d at index %lld, reversed back: ",
+           simdLevelName(simdActiveLevel()), findMaxSimd(arr2, size), target,
+           linearSearchSimd(arr2, size, target));
+    reverseArraySimd(arr2, size);
+    printArray(arr2, size);
+    
+    // O(n log n) in the worst case, unlike bubble and selection sort
+    int arr3[] = {64, 34, 25, 12, 22, 11, 90, 25, 7, 64};
+    int size3 = sizeof(arr3) / sizeof(arr3[0]);
+    printf("\nBefore introsort: ");
+    printArray(arr3, size3);
+    introSortInt(arr3, size3);
+    printf("After introsort: ");
+    printArray(arr3, size3);
+    
+    // Order statistics need only a partial order
+    int arr4[] = {64, 34, 25, 12, 22, 11, 90, 25, 7, 64};
+    double percentiles[] = {0.5, 0.9, 1.0};
+    int stats[3];
+    quantilesInt(arr4, size3, percentiles, 3, stats);
+    printf("Median %d, p90 %d, max %d; ", stats[0], stats[1], stats[2]);
+    nthElementInt(arr4, size3, 2);
+    printf("3rd smallest: %d\n", arr4[2]);
+    double prices[] = {19.99, 4.5, 100.0, -3.25, 4.5, 0.0};
+    introSortDouble(prices, 6);
+    printf("Sorted doubles: ");
+    for (int i = 0; i < 6; i++) printf("%g ", prices[i]);
+    printf("\n");
+    
+    size_t big = argc > 1 ? (size_t)atoll(argv[1]) : 1000000;
+    printf("\nSorting %zu elements:\n", big);
+    int *input = (int*)malloc(big * sizeof(int));
+    unsigned long long seed = 88172645463325252ULL;
+    for (size_t i = 0; i < big; i++) input[i] = (int)(nextRandom(&seed) >> 33);
+    compareIntSorts("random", input, big);
+    for (size_t i = 0; i < big; i++) input[i] = (int)(nextRandom(&seed) % 16);
+    compareIntSorts("few unique", input, big);
+    for (size_t i = 0; i < big; i++) input[i] = (int)i;
+    compareIntSorts("sorted", input, big);
+    for (size_t i = 0; i < big; i++) input[i] = (int)(big - i);
+    compareIntSorts("reversed", input, big);
+    
+    // Runs sorted per thread, then merged in parallel
+    int pool_threads = argc > 2 ? atoi(argv[2]) : 4;
+    SortPool *pool = createSortPool(pool_threads);
+    for (size_t i = 0; i < big; i++) input[i] = (int)(nextRandom(&seed) >> 33);
+    double start = nowSeconds();
+    parallelMergeSortInt(pool, input, big);
+    printf("  %-10s parallel merge sort (%d threads) %7.3f s  %s\n", "random", pool_threads,
+           nowSeconds() - start, isSortedInts(input, big) ? "OK" : "MISMATCH");
+    freeSortPool(pool);
+    free(input);
+    
+    double *values = (double*)malloc(big * sizeof(double));
+    double *copy = (double*)malloc(big * sizeof(double));
+    for (size_t i = 0; i < big; i++) {
+        values[i] = copy[i] = (double)(nextRandom(&seed) >> 11) / 9007199254740992.0;
+    }
+    start = nowSeconds();
+    introSortDouble(values, big);
+    double t_intro = nowSeconds() - start;
+    start = nowSeconds();
+    qsort(copy, big, sizeof(double), compareDoubles);
+    double t_qsort = nowSeconds() - start;
+    bool same = true;
+    for (size_t i = 0; i < big && same; i++) same = values[i] == copy[i];
+    printf("  %-10s introSort %7.3f s, qsort %7.3f s (%5.1fx)  %s\n", "doubles", t_intro, t_qsort,
+           t_qsort / t_intro, same ? "OK" : "MISMATCH");
+    free(values);
+    free(copy);
+    printf("Usage: ./array_algorithms [elements] [threads]\n");
+    
     return 0;
 }
@@ -0,0 +1,390 @@
+/*
+ * parallel_sort.c
+ * Parallel merge sort on a persistent thread pool
+ * Topics: thread pools with barriers, co-rank (merge path) splitting,
+ *         double buffering, sample-based parallel selection
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include <stdbool.h>
+#include <pthread.h>
+#include "parallel_sort.h"
+#include "sorting.h"
+#include "selection.h"
+
+// ===== Thread pool =====
+// Workers wait on the start barrier, run the job with their thread id
+// and meet again on the done barrier. The caller is thread 0.
+
+typedef struct {
+    SortPool *pool;
+    int id;
+} PoolWorker;
+
+struct SortPool {
+    int num_threads;
+    pthread_t *threads;
+    PoolWorker *workers;
+    pthread_barrier_t start;
+    pthread_barrier_t done;
+    pthread_barrier_t step;         // For jobs with phases
+    void (*job)(void *context, int thread);
+    void *context;
+    bool stopping;
+
+    int *buffer;                    // Merge target, grown on demand
+    size_t buffer_size;
+};
+
+static void* poolWorker(void *arg) {
+    PoolWorker *w = (PoolWorker*)arg;
+    SortPool *pool = w->pool;
+    while (true) {
+        pthread_barrier_wait(&pool->start);
+        if (pool->stopping) break;
+        pool->job(pool->context, w->id);
+        pthread_barrier_wait(&pool->done);
+    }
+    return NULL;
+}
+
+// Run job on every thread of the pool and wait for all of them
+static void poolRun(SortPool *pool, void (*job)(void*, int), void *context) {
+    pool->job = job;
+    pool->context = context;
+    pthread_barrier_wait(&pool->start);
+    job(context, 0);
+    pthread_barrier_wait(&pool->done);
+}
+
+SortPool* createSortPool(int num_threads) {
+    SortPool *pool = (SortPool*)malloc(sizeof(SortPool));
+    if (num_threads < 1) num_threads = 1;
+    pool->num_threads = num_threads;
+    pool->threads = (pthread_t*)malloc(num_threads * sizeof(pthread_t));
+    pool->workers = (PoolWorker*)malloc(num_threads * sizeof(PoolWorker));
+    pthread_barrier_init(&pool->start, NULL, num_threads);
+    pthread_barrier_init(&pool->done, NULL, num_threads);
+    pthread_barrier_init(&pool->step, NULL, num_threads);
+    pool->stopping = false;
+    pool->buffer = NULL;
+    pool->buffer_size = 0;
+
+    for (int t = 0; t < num_threads; t++) {
+        pool->workers[t].pool = pool;
+        pool->workers[t].id = t;
+        if (t > 0) pthread_create(&pool->threads[t], NULL, poolWorker, &pool->workers[t]);
+    }
+    return pool;
+}
+
+void freeSortPool(SortPool *pool) {
+    if (pool == NULL) return;
+    pool->stopping = true;
+    pthread_barrier_wait(&pool->start);
+    for (int t = 1; t < pool->num_threads; t++) {
+        pthread_join(pool->threads[t], NULL);
+    }
+    pthread_barrier_destroy(&pool->start);
+    pthread_barrier_destroy(&pool->done);
+    pthread_barrier_destroy(&pool->step);
+    free(pool->buffer);
+    free(pool->workers);
+    free(pool->threads);
+    free(pool);
+}
+
+// ===== Merging =====
+
+// Number of elements taken from a among the first k outputs of a
+// stable merge of a and b (ties come from a first)
+static size_t coRank(size_t k, const int *a, size_t len_a, const int *b, size_t len_b) {
+    size_t lo = k > len_b ? k - len_b : 0;
+    size_t hi = k < len_a ? k : len_a;
+    while (lo < hi) {
+        size_t i = lo + (hi - lo) / 2;
+        if (b[k - i - 1] < a[i]) hi = i; else lo = i + 1;
+    }
+    return lo;
+}
+
+// The select compiles to conditional moves: no branch on the data
+static void mergeRange(const int *a, size_t len_a, const int *b, size_t len_b, int *out) {
+    size_t i = 0, j = 0, k = 0;
+    while (i < len_a && j < len_b) {
+        bool take_b = b[j] < a[i];
+        out[k++] = take_b ? b[j] : a[i];
+        j += take_b;
+        i += !take_b;
+    }
+    memcpy(out + k, a + i, (len_a - i) * sizeof(int));
+    k += len_a - i;
+    memcpy(out + k, b + j, (len_b - j) * sizeof(int));
+}
+
+typedef struct {
+    SortPool *pool;
+    int *arr;
+    size_t size;
+} SortJob;
+
+// Start of run r of num_runs equal runs
+static inline size_t runStart(size_t size, int num_runs, int r) {
+    return (size_t)((unsigned long long)size * r / num_runs);
+}
+
+static void sortJob(void *context, int thread) {
+    SortJob *job = (SortJob*)context;
+    SortPool *pool = job->pool;
+    int runs = pool->num_threads;
+    size_t size = job->size;
+
+    introSortInt(job->arr + runStart(size, runs, thread),
+                 runStart(size, runs, thread + 1) - runStart(size, runs, thread));
+
+    // Each round merges pairs of width-run groups from src into dst.
+    // This thread writes output slice [out_begin, out_end) of the round.
+    int *src = job->arr;
+    int *dst = pool->buffer;
+    size_t out_begin = runStart(size, runs, thread);
+    size_t out_end = runStart(size, runs, thread + 1);
+    for (int width = 1; width < runs; width *= 2) {
+        pthread_barrier_wait(&pool->step);
+        for (int first = 0; first < runs; first += 2 * width) {
+            size_t pair_begin = runStart(size, runs, first);
+            size_t mid = runStart(size, runs, first + width < runs ? first + width : runs);
+            size_t pair_end = runStart(size, runs, first + 2 * width < runs ? first + 2 * width : runs);
+            if (pair_end <= out_begin || pair_begin >= out_end) continue;
+
+            // This thread's part of the pair's output, in pair-relative ranks
+            size_t lo = (out_begin > pair_begin ? out_begin : pair_begin) - pair_begin;
+            size_t hi = (out_end < pair_end ? out_end : pair_end) - pair_begin;
+            const int *a = src + pair_begin;
+            const int *b = src + mid;
+            size_t len_a = mid - pair_begin, len_b = pair_end - mid;
+            size_t i_lo = coRank(lo, a, len_a, b, len_b);
+            size_t i_hi = coRank(hi, a, len_a, b, len_b);
+            mergeRange(a + i_lo, i_hi - i_lo, b + (lo - i_lo), (hi - i_hi) - (lo - i_lo),
+                       dst + pair_begin + lo);
+        }
+        int *tmp = src;
+        src = dst;
+        dst = tmp;
+    }
+
+    // An odd number of rounds leaves the result in the buffer
+    if (src != job->arr) {
+        pthread_barrier_wait(&pool->step);
+        memcpy(job->arr + out_begin, src + out_begin, (out_end - out_begin) * sizeof(int));
+    }
+}
+
+void parallelMergeSortInt(SortPool *pool, int *arr, size_t size) {
+    if (pool->num_threads == 1 || size < (size_t)pool->num_threads * 1024) {
+        introSortInt(arr, size);
+        return;
+    }
+    if (pool->buffer_size < size) {
+        free(pool->buffer);
+        pool->buffer = (int*)malloc(size * sizeof(int));
+        pool->buffer_size = size;
+    }
+    SortJob job = { pool, arr, size };
+    poolRun(pool, sortJob, &job);
+}
+
+// ===== Selection =====
+// Quantiles of a large array without reordering it. A random sample,
+// sorted, gives for every requested rank two keys that bracket it with
+// high probability. One parallel pass counts, per thread, the elements
+// below the bracket and inside it; a second pass copies the elements
+// inside into a small buffer, where introselect finds the answer.
+
+#define SELECT_SAMPLE (1 << 18)     // Sample size: brackets hold ~1% of the input
+#define SELECT_MARGIN 1024          // Sample positions on each side: 4 standard deviations
+#define SELECT_BLOCK 4096           // Elements tested against all brackets at once
+
+typedef struct {
+    const int *arr;
+    size_t size;
+    size_t num_quantiles;
+    int runs;
+    const int *low;                 // Bracket of quantile q: [low[q], high[q]]
+    const int *high;
+    size_t *below;                  // Per thread and quantile: [thread * num_quantiles + q]
+    size_t *inside;                 // Counts, then where the copy pass writes next
+    int **buffers;                  // Per quantile, filled by the copy pass
+} SelectJob;
+
+// Elements of arr[0, n) below low and inside [low, high]. Full blocks
+// pass n == SELECT_BLOCK: with a constant trip count the compiler
+// vectorizes the loop even at -O2.
+static inline void countBracket(const int *arr, size_t n, int low, int high, size_t *below,
+                                size_t *inside) {
+    unsigned count_below = 0, count_inside = 0;
+    for (size_t i = 0; i < n; i++) {
+        int x = arr[i];
+        count_below += x < low;
+        count_inside += (x >= low) & (x <= high);
+    }
+    *below += count_below;
+    *inside += count_inside;
+}
+
+static void countJob(void *context, int thread) {
+    SelectJob *job = (SelectJob*)context;
+    size_t begin = runStart(job->size, job->runs, thread);
+    size_t end = runStart(job->size, job->runs, thread + 1);
+    size_t *below = job->below + (size_t)thread * job->num_quantiles;
+    size_t *inside = job->inside + (size_t)thread * job->num_quantiles;
+
+    for (size_t q = 0; q < job->num_quantiles; q++) below[q] = inside[q] = 0;
+    // Blocks stay in L1 while every bracket is tested, so the input is
+    // read from memory once
+    size_t block = begin;
+    for (; block + SELECT_BLOCK <= end; block += SELECT_BLOCK) {
+        for (size_t q = 0; q < job->num_quantiles; q++) {
+            countBracket(job->arr + block, SELECT_BLOCK, job->low[q], job->high[q], &below[q],
+                         &inside[q]);
+        }
+    }
+    for (size_t q = 0; q < job->num_quantiles; q++) {
+        countBracket(job->arr + block, end - block, job->low[q], job->high[q], &below[q],
+                     &inside[q]);
+    }
+}
+
+static void copyJob(void *context, int thread) {
+    SelectJob *job = (SelectJob*)context;
+    size_t begin = runStart(job->size, job->runs, thread);
+    size_t end = runStart(job->size, job->runs, thread + 1);
+    size_t *offsets = job->inside + (size_t)thread * job->num_quantiles;
+    int staged[SELECT_BLOCK];
+
+    for (size_t block = begin; block < end; block += SELECT_BLOCK) {
+        size_t block_end = block + SELECT_BLOCK < end ? block + SELECT_BLOCK : end;
+        for (size_t q = 0; q < job->num_quantiles; q++) {
+            if (job->buffers[q] == NULL) continue;
+            // Store every element, advance only past the ones inside:
+            // no branch on the data. The staging buffer absorbs the
+            // stores of the elements that are not kept.
+            int low = job->low[q], high = job->high[q];
+            size_t count = 0;
+            for (size_t i = block; i < block_end; i++) {
+                int x = job->arr[i];
+                staged[count] = x;
+                count += (x >= low) & (x <= high);
+            }
+            memcpy(job->buffers[q] + offsets[q], staged, count * sizeof(int));
+            offsets[q] += count;
+        }
+    }
+}
+
+// Sample keys at distance margin on either side of the rank's expected
+// sample position, or the whole int range past the end of the sample
+static void bracketRank(const int *sample, size_t rank, size_t size, size_t margin, int *low,
+                        int *high) {
+    size_t pos = (size_t)((unsigned long long)rank * SELECT_SAMPLE / size);
+    *low = pos >= margin ? sample[pos - margin] : INT_MIN;
+    *high = pos + margin < SELECT_SAMPLE ? sample[pos + margin] : INT_MAX;
+}
+
+void parallelQuantilesInt(SortPool *pool, const int *arr, size_t size, const double *quantiles,
+                          size_t num_quantiles, int *out) {
+    if (size < 4 * (size_t)SELECT_SAMPLE) {
+        int *copy = (int*)malloc((size > 0 ? size : 1) * sizeof(int));
+        memcpy(copy, arr, size * sizeof(int));
+        quantilesInt(copy, size, quantiles, num_quantiles, out);
+        free(copy);
+        return;
+    }
+
+    size_t nq = num_quantiles;
+    int *sample = (int*)malloc(SELECT_SAMPLE * sizeof(int));
+    unsigned long long seed = 0x9E3779B97F4A7C15ULL;
+    for (size_t i = 0; i < SELECT_SAMPLE; i++) {
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        sample[i] = arr[(seed >> 11) % size];
+    }
+    introSortInt(sample, SELECT_SAMPLE);
+
+    size_t *ranks = (size_t*)malloc((nq > 0 ? nq : 1) * sizeof(size_t));
+    size_t *margins = (size_t*)malloc((nq > 0 ? nq : 1) * sizeof(size_t));
+    int *low = (int*)malloc((nq > 0 ? nq : 1) * sizeof(int));
+    int *high = (int*)malloc((nq > 0 ? nq : 1) * sizeof(int));
+    int **buffers = (int**)malloc((nq > 0 ? nq : 1) * sizeof(int*));
+    size_t *buffer_sizes = (size_t*)malloc((nq > 0 ? nq : 1) * sizeof(size_t));
+    size_t per_thread = (size_t)pool->num_threads * (nq > 0 ? nq : 1);
+    size_t *below = (size_t*)malloc(per_thread * sizeof(size_t));
+    size_t *inside = (size_t*)malloc(per_thread * sizeof(size_t));
+    for (size_t q = 0; q < nq; q++) {
+        ranks[q] = quantileRank(size, quantiles[q]);
+        margins[q] = SELECT_MARGIN;
+        bracketRank(sample, ranks[q], size, margins[q], &low[q], &high[q]);
+    }
+
+    SelectJob job = { arr, size, nq, pool->num_threads, low, high, below, inside, buffers };
+    bool all_found;
+    do {
+        poolRun(pool, countJob, &job);
+        // A rank outside its bracket (the sample was unlucky) gets a
+        // wider one; the bracket always grows to the full range eventually
+        all_found = true;
+        for (size_t q = 0; q < nq; q++) {
+            size_t total_below = 0, total_inside = 0;
+            for (int t = 0; t < pool->num_threads; t++) {
+                total_below += below[(size_t)t * nq + q];
+                total_inside += inside[(size_t)t * nq + q];
+            }
+            if (ranks[q] < total_below || ranks[q] >= total_below + total_inside) {
+                margins[q] *= 4;
+                bracketRank(sample, ranks[q], size, margins[q], &low[q], &high[q]);
+                all_found = false;
+            }
+        }
+    } while (!all_found);
+
+    // Turn counts into each thread's output offset in the buffers
+    for (size_t q = 0; q < nq; q++) {
+        size_t offset = 0;
+        for (int t = 0; t < pool->num_threads; t++) {
+            size_t count = inside[(size_t)t * nq + q];
+            inside[(size_t)t * nq + q] = offset;
+            offset += count;
+        }
+        // Equal brackets need no copy: every element inside is the answer
+        buffers[q] = low[q] == high[q] ? NULL : (int*)malloc(offset * sizeof(int));
+        buffer_sizes[q] = offset;
+    }
+    poolRun(pool, copyJob, &job);
+
+    for (size_t q = 0; q < nq; q++) {
+        if (buffers[q] == NULL) {
+            out[q] = low[q];
+            continue;
+        }
+        size_t total_below = 0;
+        for (int t = 0; t < pool->num_threads; t++) total_below += below[(size_t)t * nq + q];
+        size_t k = ranks[q] - total_below;
+        nthElementInt(buffers[q], buffer_sizes[q], k);
+        out[q] = buffers[q][k];
+        free(buffers[q]);
+    }
+
+    free(inside);
+    free(below);
+    free(buffer_sizes);
+    free(buffers);
+    free(high);
+    free(low);
+    free(margins);
+    free(ranks);
+    free(sample);
+}
@@ -0,0 +1,55 @@
+/*
+ * parallel_sort.h
+ * Multi-threaded merge sort of int arrays
+ *
+ * Each thread sorts one contiguous run with introSortInt, then the runs
+ * are merged pairwise in log2(threads) rounds. Within a round the output
+ * is cut into one equal slice per thread; a thread finds where its slice
+ * starts in both input runs by binary search on the co-rank (how many
+ * of the first k outputs come from each run), so every thread merges
+ * the same number of elements no matter how the data is distributed.
+ *
+ * The threads live in a SortPool, created once and reused by every sort
+ * so that repeated sorts do not pay for thread creation. The pool also
+ * keeps the n-element merge buffer between calls.
+ *
+ * The pool also answers quantile queries (see selection.h) on arrays too
+ * large to copy or sort: a sorted random sample brackets each requested
+ * rank between two keys, the threads count and then copy the elements
+ * inside the brackets (about 1% of the input), and introselect finishes
+ * on that copy.
+ */
+
+#ifndef PARALLEL_SORT_H
+#define PARALLEL_SORT_H
+
+#include <stddef.h>
+
+typedef struct SortPool SortPool;
+
+/**
+ * @brief Start a pool of worker threads
+ * @param num_threads Threads sorting, including the caller
+ */
+SortPool* createSortPool(int num_threads);
+
+/**
+ * @brief Stop the workers and release the pool
+ */
+void freeSortPool(SortPool *pool);
+
+/**
+ * @brief Sort ascending using every thread of the pool
+ */
+void parallelMergeSortInt(SortPool *pool, int *arr, size_t size);
+
+/**
+ * @brief Quantiles of arr, as quantilesInt() would return them
+ *
+ * arr is not modified. Small arrays are copied and selected serially.
+ * @param out Receives num_quantiles values, out[i] for quantiles[i]
+ */
+void parallelQuantilesInt(SortPool *pool, const int *arr, size_t size, const double *quantiles,
+                          size_t num_quantiles, int *out);
+
+#endif /* PARALLEL_SORT_H */
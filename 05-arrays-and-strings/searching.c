@@ -0,0 +1,59 @@
+/*
+ * searching.c
+ * Branchless and batched binary search
+ * Topics: conditional moves, software prefetching, memory-level
+ *         parallelism
+ *
+ * Both searches keep a base pointer and a length n. A step looks at
+ * base[n / 2] and either keeps base or moves it past the middle; the
+ * next step then reads base[n' / 2] or base[n / 2 + n' / 2], so both are
+ * prefetched while the current comparison resolves.
+ */
+
+#include "searching.h"
+
+size_t lowerBoundInt(const int *arr, size_t size, int key) {
+    if (size == 0) return 0;
+    const int *base = arr;
+    size_t n = size;
+    while (n > 1) {
+        size_t half = n / 2;
+        size_t next_half = (n - half) / 2;
+        __builtin_prefetch(base + next_half);
+        __builtin_prefetch(base + half + next_half);
+        base = base[half] < key ? base + half : base;
+        n -= half;
+    }
+    return (size_t)(base - arr) + (*base < key);
+}
+
+void lowerBoundBatchInt(const int *arr, size_t size, const int *keys, size_t num_keys,
+                        size_t *out) {
+    if (size == 0) {
+        for (size_t k = 0; k < num_keys; k++) out[k] = 0;
+        return;
+    }
+
+    const int *base[SEARCH_BATCH];
+    for (size_t first = 0; first < num_keys; first += SEARCH_BATCH) {
+        size_t count = num_keys - first < SEARCH_BATCH ? num_keys - first : SEARCH_BATCH;
+        const int *batch_keys = keys + first;
+        for (size_t g = 0; g < count; g++) base[g] = arr;
+
+        // All searches share the length sequence, only bases differ
+        size_t n = size;
+        while (n > 1) {
+            size_t half = n / 2;
+            size_t next_half = (n - half) / 2;
+            // Once base[g] is known, so is its next probe: prefetch just that
+            for (size_t g = 0; g < count; g++) {
+                base[g] = base[g][half] < batch_keys[g] ? base[g] + half : base[g];
+                __builtin_prefetch(base[g] + next_half);
+            }
+            n -= half;
+        }
+        for (size_t g = 0; g < count; g++) {
+            out[first + g] = (size_t)(base[g] - arr) + (*base[g] < batch_keys[g]);
+        }
+    }
+}
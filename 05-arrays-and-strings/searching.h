@@ -0,0 +1,36 @@
+/*
+ * searching.h
+ * Lower-bound search in sorted int arrays, one key or many at a time
+ *
+ * lowerBoundInt()      - branchless: each step halves the range with a
+ *                        conditional move instead of a branch, so there
+ *                        are no mispredictions, and it prefetches both
+ *                        elements the next step may look at
+ * lowerBoundBatchInt() - runs SEARCH_BATCH independent searches in
+ *                        lockstep; every step issues all their loads
+ *                        before using any of them, so the cache misses
+ *                        of large arrays overlap instead of queueing
+ */
+
+#ifndef SEARCHING_H
+#define SEARCHING_H
+
+#include <stddef.h>
+
+#define SEARCH_BATCH 16     // Searches kept in flight by the batch API
+
+/**
+ * @brief First position whose element is not less than key
+ * @param arr Array sorted in ascending order
+ * @return Index in [0, size]; size if every element is less than key
+ */
+size_t lowerBoundInt(const int *arr, size_t size, int key);
+
+/**
+ * @brief lowerBoundInt for many keys
+ * @param out Receives num_keys positions, out[i] for keys[i]
+ */
+void lowerBoundBatchInt(const int *arr, size_t size, const int *keys, size_t num_keys,
+                        size_t *out);
+
+#endif /* SEARCHING_H */
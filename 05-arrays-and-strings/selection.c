@@ -0,0 +1,60 @@
+/*
+ * selection.c
+ * Median and multi-quantile selection
+ * Topics: order statistics, multi-rank selection
+ */
+
+#include <stdlib.h>
+#include "selection.h"
+
+int medianInt(int *arr, size_t size) {
+    if (size == 0) return 0;
+    size_t k = (size - 1) / 2;
+    nthElementInt(arr, size, k);
+    return arr[k];
+}
+
+size_t quantileRank(size_t size, double q) {
+    if (size == 0 || q <= 0) return 0;
+    if (q >= 1) return size - 1;
+    return (size_t)(q * (double)(size - 1) + 0.5);
+}
+
+// Place every rank in ranks[first, last) (ascending) that lies inside
+// [lo, hi); the rest of the array is already partitioned around them
+static void selectRanks(int *arr, size_t lo, size_t hi, const size_t *ranks, size_t first,
+                        size_t last) {
+    while (first < last && ranks[first] < lo) first++;
+    while (last > first && ranks[last - 1] >= hi) last--;
+    if (first >= last) return;
+
+    size_t mid = first + (last - first) / 2;
+    size_t k = ranks[mid];
+    nthElementInt(arr + lo, hi - lo, k - lo);
+    selectRanks(arr, lo, k, ranks, first, mid);
+    selectRanks(arr, k + 1, hi, ranks, mid + 1, last);
+}
+
+void quantilesInt(int *arr, size_t size, const double *quantiles, size_t num_quantiles,
+                  int *out) {
+    if (size == 0) {
+        for (size_t i = 0; i < num_quantiles; i++) out[i] = 0;
+        return;
+    }
+    if (num_quantiles == 0) return;
+
+    size_t *ranks = (size_t*)malloc(num_quantiles * sizeof(size_t));
+    for (size_t i = 0; i < num_quantiles; i++) {
+        size_t rank = quantileRank(size, quantiles[i]);
+        size_t j = i;
+        while (j > 0 && ranks[j - 1] > rank) {
+            ranks[j] = ranks[j - 1];
+            j--;
+        }
+        ranks[j] = rank;
+    }
+
+    selectRanks(arr, 0, size, ranks, 0, num_quantiles);
+    for (size_t i = 0; i < num_quantiles; i++) out[i] = arr[quantileRank(size, quantiles[i])];
+    free(ranks);
+}
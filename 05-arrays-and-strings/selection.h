@@ -0,0 +1,59 @@
+/*
+ * selection.h
+ * k-th smallest element, median and quantiles without sorting
+ *
+ * nthElement*()   - introselect: the pdqsort partitioning of sorting.h
+ *                   (median-of-3 or ninther pivot, branchless blocks,
+ *                   runs of equal keys in one pass), continued only in
+ *                   the side holding k, in expected linear time. After
+ *                   log2(n) badly unbalanced partitions it switches to
+ *                   median-of-medians pivots, which bounds the worst
+ *                   case at O(n) as well
+ * quantilesInt()  - several ranks in one call: select the middle rank,
+ *                   then the ranks left and right of it inside the two
+ *                   halves only, so q quantiles cost O(n log q)
+ *
+ * A quantile q in [0, 1] is the element of rank round(q * (size - 1)) in
+ * ascending order: 0 is the minimum, 0.5 the median, 1 the maximum.
+ * parallelQuantilesInt() in parallel_sort.h answers the same queries
+ * with several threads and leaves the input untouched.
+ */
+
+#ifndef SELECTION_H
+#define SELECTION_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Partially reorder arr so that arr[k] is the k-th smallest
+ *
+ * Elements before k end up no greater than arr[k], elements after it
+ * no smaller. Does nothing if k >= size. Defined in sorting.c.
+ */
+void nthElementInt(int *arr, size_t size, size_t k);
+void nthElementInt64(int64_t *arr, size_t size, size_t k);
+void nthElementFloat(float *arr, size_t size, size_t k);
+void nthElementDouble(double *arr, size_t size, size_t k);
+
+/**
+ * @brief Lower median (rank (size - 1) / 2); reorders arr
+ * @return The median, or 0 for an empty array
+ */
+int medianInt(int *arr, size_t size);
+
+/**
+ * @brief Rank of quantile q in an array of size elements
+ * @return Nearest rank in 0 .. size - 1, or 0 for an empty array
+ */
+size_t quantileRank(size_t size, double q);
+
+/**
+ * @brief Several quantiles at once; reorders arr
+ * @param quantiles num_quantiles values in [0, 1], in any order
+ * @param out Receives num_quantiles values, out[i] for quantiles[i]
+ */
+void quantilesInt(int *arr, size_t size, const double *quantiles, size_t num_quantiles,
+                  int *out);
+
+#endif /* SELECTION_H */
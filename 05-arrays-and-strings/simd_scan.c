@@ -0,0 +1,289 @@
+/*
+ * simd_scan.c
+ * SSE2 / AVX2 / AVX-512 scans with runtime CPU dispatch
+ * Topics: compile-time architecture detection, per-function target
+ *         attributes, CPU feature detection, function pointer dispatch
+ *
+ * Compile time decides which versions can exist (an x86 target and a
+ * compiler that understands target attributes); run time decides which
+ * one is used, so one binary runs on any x86-64 and still uses AVX-512
+ * where it is available.
+ */
+
+#include <limits.h>
+#include <stdatomic.h>
+#include "simd_scan.h"
+
+// Conditional compilation based on architecture and compiler
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define SIMD_X86 1
+    #define TARGET(isa) __attribute__((target(isa)))
+    #include <immintrin.h>
+#else
+    #define SIMD_X86 0
+#endif
+
+// ===== Scalar =====
+
+static long long linearSearchScalar(const int *arr, size_t size, int target) {
+    for (size_t i = 0; i < size; i++) {
+        if (arr[i] == target) return (long long)i;
+    }
+    return -1;
+}
+
+static int findMaxScalar(const int *arr, size_t size) {
+    int max = INT_MIN;
+    for (size_t i = 0; i < size; i++) {
+        if (arr[i] > max) max = arr[i];
+    }
+    return max;
+}
+
+static void reverseScalar(int *arr, size_t begin, size_t end) {
+    while (begin + 1 < end) {
+        int temp = arr[begin];
+        arr[begin++] = arr[--end];
+        arr[end] = temp;
+    }
+}
+
+static void reverseArrayScalar(int *arr, size_t size) {
+    reverseScalar(arr, 0, size);
+}
+
+#if SIMD_X86
+
+// ===== SSE2 (4 ints per vector) =====
+// Searches test four vectors per iteration and only look for the exact
+// lane once some lane matched.
+
+TARGET("sse2")
+static long long linearSearchSSE2(const int *arr, size_t size, int target) {
+    __m128i key = _mm_set1_epi32(target);
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        __m128i eq0 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(arr + i)), key);
+        __m128i eq1 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(arr + i + 4)), key);
+        __m128i eq2 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(arr + i + 8)), key);
+        __m128i eq3 = _mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(arr + i + 12)), key);
+        __m128i any = _mm_or_si128(_mm_or_si128(eq0, eq1), _mm_or_si128(eq2, eq3));
+        if (_mm_movemask_epi8(any) != 0) break;
+    }
+    long long found = linearSearchScalar(arr + i, size - i, target);
+    return found < 0 ? -1 : (long long)i + found;
+}
+
+// SSE2 has no 32-bit max: select with a compare mask instead
+TARGET("sse2")
+static inline __m128i max32SSE2(__m128i a, __m128i b) {
+    __m128i a_greater = _mm_cmpgt_epi32(a, b);
+    return _mm_or_si128(_mm_and_si128(a_greater, a), _mm_andnot_si128(a_greater, b));
+}
+
+TARGET("sse2")
+static int findMaxSSE2(const int *arr, size_t size) {
+    __m128i max0 = _mm_set1_epi32(INT_MIN), max1 = max0;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        max0 = max32SSE2(max0, _mm_loadu_si128((const __m128i*)(arr + i)));
+        max1 = max32SSE2(max1, _mm_loadu_si128((const __m128i*)(arr + i + 4)));
+    }
+    max0 = max32SSE2(max0, max1);
+    max0 = max32SSE2(max0, _mm_shuffle_epi32(max0, _MM_SHUFFLE(1, 0, 3, 2)));
+    max0 = max32SSE2(max0, _mm_shuffle_epi32(max0, _MM_SHUFFLE(2, 3, 0, 1)));
+    int max = _mm_cvtsi128_si32(max0);
+    int tail = findMaxScalar(arr + i, size - i);
+    return tail > max ? tail : max;
+}
+
+// Swap a vector from each end, reversing the lanes of both
+TARGET("sse2")
+static void reverseArraySSE2(int *arr, size_t size) {
+    size_t lo = 0, hi = size;
+    while (hi - lo >= 8) {
+        __m128i left = _mm_loadu_si128((const __m128i*)(arr + lo));
+        __m128i right = _mm_loadu_si128((const __m128i*)(arr + hi - 4));
+        _mm_storeu_si128((__m128i*)(arr + lo), _mm_shuffle_epi32(right, _MM_SHUFFLE(0, 1, 2, 3)));
+        _mm_storeu_si128((__m128i*)(arr + hi - 4), _mm_shuffle_epi32(left, _MM_SHUFFLE(0, 1, 2, 3)));
+        lo += 4;
+        hi -= 4;
+    }
+    reverseScalar(arr, lo, hi);
+}
+
+// ===== AVX2 (8 ints per vector) =====
+
+TARGET("avx2")
+static long long linearSearchAVX2(const int *arr, size_t size, int target) {
+    __m256i key = _mm256_set1_epi32(target);
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        __m256i eq0 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(arr + i)), key);
+        __m256i eq1 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(arr + i + 8)), key);
+        __m256i eq2 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(arr + i + 16)), key);
+        __m256i eq3 = _mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(arr + i + 24)), key);
+        __m256i any = _mm256_or_si256(_mm256_or_si256(eq0, eq1), _mm256_or_si256(eq2, eq3));
+        if (!_mm256_testz_si256(any, any)) break;
+    }
+    long long found = linearSearchScalar(arr + i, size - i, target);
+    return found < 0 ? -1 : (long long)i + found;
+}
+
+TARGET("avx2")
+static int findMaxAVX2(const int *arr, size_t size) {
+    __m256i max0 = _mm256_set1_epi32(INT_MIN), max1 = max0;
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        max0 = _mm256_max_epi32(max0, _mm256_loadu_si256((const __m256i*)(arr + i)));
+        max1 = _mm256_max_epi32(max1, _mm256_loadu_si256((const __m256i*)(arr + i + 8)));
+    }
+    max0 = _mm256_max_epi32(max0, max1);
+    __m128i max = _mm_max_epi32(_mm256_castsi256_si128(max0), _mm256_extracti128_si256(max0, 1));
+    max = _mm_max_epi32(max, _mm_shuffle_epi32(max, _MM_SHUFFLE(1, 0, 3, 2)));
+    max = _mm_max_epi32(max, _mm_shuffle_epi32(max, _MM_SHUFFLE(2, 3, 0, 1)));
+    int result = _mm_cvtsi128_si32(max);
+    int tail = findMaxScalar(arr + i, size - i);
+    return tail > result ? tail : result;
+}
+
+TARGET("avx2")
+static void reverseArrayAVX2(int *arr, size_t size) {
+    const __m256i reversed = _mm256_setr_epi32(7, 6, 5, 4, 3, 2, 1, 0);
+    size_t lo = 0, hi = size;
+    while (hi - lo >= 16) {
+        __m256i left = _mm256_loadu_si256((const __m256i*)(arr + lo));
+        __m256i right = _mm256_loadu_si256((const __m256i*)(arr + hi - 8));
+        _mm256_storeu_si256((__m256i*)(arr + lo), _mm256_permutevar8x32_epi32(right, reversed));
+        _mm256_storeu_si256((__m256i*)(arr + hi - 8), _mm256_permutevar8x32_epi32(left, reversed));
+        lo += 8;
+        hi -= 8;
+    }
+    reverseScalar(arr, lo, hi);
+}
+
+// ===== AVX-512 (16 ints per vector) =====
+// Compares produce bit masks directly, so the tail is handled with a
+// masked load instead of a scalar loop.
+
+TARGET("avx512f")
+static long long linearSearchAVX512(const int *arr, size_t size, int target) {
+    __m512i key = _mm512_set1_epi32(target);
+    size_t i = 0;
+    for (; i + 64 <= size; i += 64) {
+        __mmask16 m0 = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(arr + i), key);
+        __mmask16 m1 = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(arr + i + 16), key);
+        __mmask16 m2 = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(arr + i + 32), key);
+        __mmask16 m3 = _mm512_cmpeq_epi32_mask(_mm512_loadu_si512(arr + i + 48), key);
+        if ((m0 | m1 | m2 | m3) != 0) break;
+    }
+    for (; i < size; i += 16) {
+        size_t left = size - i;
+        __mmask16 valid = left >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << left) - 1);
+        __mmask16 hits = _mm512_mask_cmpeq_epi32_mask(valid, _mm512_maskz_loadu_epi32(valid, arr + i),
+                                                      key);
+        if (hits != 0) return (long long)i + __builtin_ctz(hits);
+    }
+    return -1;
+}
+
+TARGET("avx512f")
+static int findMaxAVX512(const int *arr, size_t size) {
+    __m512i max0 = _mm512_set1_epi32(INT_MIN), max1 = max0;
+    size_t i = 0;
+    for (; i + 32 <= size; i += 32) {
+        max0 = _mm512_max_epi32(max0, _mm512_loadu_si512(arr + i));
+        max1 = _mm512_max_epi32(max1, _mm512_loadu_si512(arr + i + 16));
+    }
+    for (; i < size; i += 16) {
+        size_t left = size - i;
+        __mmask16 valid = left >= 16 ? (__mmask16)0xFFFF : (__mmask16)((1u << left) - 1);
+        max0 = _mm512_mask_max_epi32(max0, valid, max0, _mm512_maskz_loadu_epi32(valid, arr + i));
+    }
+    return _mm512_reduce_max_epi32(_mm512_max_epi32(max0, max1));
+}
+
+TARGET("avx512f")
+static void reverseArrayAVX512(int *arr, size_t size) {
+    const __m512i reversed = _mm512_setr_epi32(15, 14, 13, 12, 11, 10, 9, 8,
+                                               7, 6, 5, 4, 3, 2, 1, 0);
+    size_t lo = 0, hi = size;
+    while (hi - lo >= 32) {
+        __m512i left = _mm512_loadu_si512(arr + lo);
+        __m512i right = _mm512_loadu_si512(arr + hi - 16);
+        _mm512_storeu_si512(arr + lo, _mm512_permutexvar_epi32(reversed, right));
+        _mm512_storeu_si512(arr + hi - 16, _mm512_permutexvar_epi32(reversed, left));
+        lo += 16;
+        hi -= 16;
+    }
+    reverseScalar(arr, lo, hi);
+}
+
+#endif /* SIMD_X86 */
+
+// ===== Dispatch =====
+
+typedef struct {
+    long long (*linear_search)(const int*, size_t, int);
+    int (*find_max)(const int*, size_t);
+    void (*reverse)(int*, size_t);
+} ScanKernels;
+
+static const ScanKernels kernels[SIMD_LEVELS] = {
+    { linearSearchScalar, findMaxScalar, reverseArrayScalar },
+#if SIMD_X86
+    { linearSearchSSE2, findMaxSSE2, reverseArraySSE2 },
+    { linearSearchAVX2, findMaxAVX2, reverseArrayAVX2 },
+    { linearSearchAVX512, findMaxAVX512, reverseArrayAVX512 },
+#endif
+};
+
+static const char *level_names[SIMD_LEVELS] = { "scalar", "SSE2", "AVX2", "AVX-512" };
+
+// Selected level, or -1 until the first call. The first scan only
+// replaces -1, so it never overrides an explicit simdSelect()
+static _Atomic int active = -1;
+
+SimdLevel simdDetect(void) {
+#if SIMD_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) return SIMD_AVX512;
+    if (__builtin_cpu_supports("avx2")) return SIMD_AVX2;
+    if (__builtin_cpu_supports("sse2")) return SIMD_SSE2;
+#endif
+    return SIMD_SCALAR;
+}
+
+SimdLevel simdSelect(SimdLevel level) {
+    SimdLevel best = simdDetect();
+    SimdLevel chosen = level < best ? level : best;
+    if (chosen < SIMD_SCALAR) chosen = SIMD_SCALAR;
+    atomic_store(&active, (int)chosen);
+    return chosen;
+}
+
+SimdLevel simdActiveLevel(void) {
+    int level = atomic_load_explicit(&active, memory_order_relaxed);
+    if (level < 0) {
+        int best = (int)simdDetect();
+        level = -1;
+        if (atomic_compare_exchange_strong(&active, &level, best)) level = best;
+    }
+    return (SimdLevel)level;
+}
+
+const char* simdLevelName(SimdLevel level) {
+    return level >= SIMD_SCALAR && level < SIMD_LEVELS ? level_names[level] : "unknown";
+}
+
+long long linearSearchSimd(const int *arr, size_t size, int target) {
+    return kernels[simdActiveLevel()].linear_search(arr, size, target);
+}
+
+int findMaxSimd(const int *arr, size_t size) {
+    return kernels[simdActiveLevel()].find_max(arr, size);
+}
+
+void reverseArraySimd(int *arr, size_t size) {
+    kernels[simdActiveLevel()].reverse(arr, size);
+}
@@ -0,0 +1,63 @@
+/*
+ * simd_scan.h
+ * Vectorized linear search, maximum and reversal of int arrays
+ *
+ * Each operation has a scalar, SSE2, AVX2 and AVX-512 version. All of
+ * them are compiled into the program (GCC/Clang target attributes, no
+ * special build flags); the first call checks which instruction sets
+ * the CPU actually supports and binds the widest one. Every version
+ * returns exactly what the scalar loop would.
+ */
+
+#ifndef SIMD_SCAN_H
+#define SIMD_SCAN_H
+
+#include <stddef.h>
+
+typedef enum {
+    SIMD_SCALAR,
+    SIMD_SSE2,
+    SIMD_AVX2,
+    SIMD_AVX512,
+    SIMD_LEVELS
+} SimdLevel;
+
+/**
+ * @brief Widest instruction set this CPU (and OS) supports
+ */
+SimdLevel simdDetect(void);
+
+/**
+ * @brief Level the scan functions currently use
+ */
+SimdLevel simdActiveLevel(void);
+
+/**
+ * @brief Use a narrower level, e.g. to compare implementations; takes
+ *        effect for scans started afterwards on any thread
+ * @return The level actually selected (never above simdDetect())
+ */
+SimdLevel simdSelect(SimdLevel level);
+
+/**
+ * @brief Printable name of a level ("scalar", "SSE2", ...)
+ */
+const char* simdLevelName(SimdLevel level);
+
+/**
+ * @brief Index of the first element equal to target
+ * @return Index, or -1 if target is not present
+ */
+long long linearSearchSimd(const int *arr, size_t size, int target);
+
+/**
+ * @brief Largest element (INT_MIN for an empty array)
+ */
+int findMaxSimd(const int *arr, size_t size);
+
+/**
+ * @brief Reverse the array in place
+ */
+void reverseArraySimd(int *arr, size_t size);
+
+#endif /* SIMD_SCAN_H */
@@ -0,0 +1,796 @@
+/*
+ * sort_benchmark.c
+ * Benchmarks for the array sorting and searching library
+ * Topics: input patterns, thread scaling, checking results against a
+ *         reference sort, machine-readable results
+ *
+ * Usage: ./sort_benchmark [parallel|search|scan|select|substring|multi|suite] [size]
+ *                         [max_threads] [table|csv|json]
+ *
+ *   parallel   thread scaling of the parallel merge sort on random,
+ *              sorted, reversed and few-unique input
+ *   search     batched and single lookups from L1-sized to DRAM-sized
+ *              arrays
+ *   scan       GB/s of the SIMD scans per instruction set
+ *   select     p50/p99/p99.9 by sorting, introselect and the parallel
+ *              sample-and-count pass
+ *   substring  the substring searcher against the naive loop, in GB/s
+ *   multi      10k keywords with Aho-Corasick, whole and streamed,
+ *              against one substring search per keyword
+ *   suite      every sort (including the textbook bubble, selection and
+ *              module 12 heap sorts) on random, sorted, reversed,
+ *              organ-pipe, few-unique and Zipf input for int, int64,
+ *              float and double, checking each result, for sizes from
+ *              1Ki up to size (default 1Mi; 1073741824 for a billion);
+ *              one row per measurement in the chosen format
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <time.h>
+#include "sorting.h"
+#include "parallel_sort.h"
+#include "searching.h"
+#include "simd_scan.h"
+#include "selection.h"
+#include "string_search.h"
+#include "aho_corasick.h"
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// xorshift64: fast reproducible test data
+static inline unsigned long long nextRandom(unsigned long long *state) {
+    *state ^= *state << 13;
+    *state ^= *state >> 7;
+    *state ^= *state << 17;
+    return *state;
+}
+
+// ===== Inputs =====
+
+typedef enum {
+    INPUT_RANDOM,
+    INPUT_SORTED,
+    INPUT_REVERSED,
+    INPUT_FEW_UNIQUE,
+    INPUT_ORGAN_PIPE,
+    INPUT_ZIPF,
+    INPUT_KINDS
+} InputKind;
+
+static const char *input_names[INPUT_KINDS] = {
+    "random", "sorted", "reversed", "few unique", "organ pipe", "zipf"
+};
+
+#define ZIPF_VALUES (1 << 16)       // Distinct values in the Zipf input
+
+// Zipf with exponent 1: the value of rank r has probability proportional
+// to 1 / (r + 1), so a few values fill most of the array. Ranks are
+// scattered over the int range; the common values are not the smallest.
+static int zipfValue(unsigned long long *seed) {
+    static double cdf[ZIPF_VALUES];
+    static bool ready = false;
+    if (!ready) {
+        double sum = 0;
+        for (size_t r = 0; r < ZIPF_VALUES; r++) cdf[r] = sum += 1.0 / (double)(r + 1);
+        for (size_t r = 0; r < ZIPF_VALUES; r++) cdf[r] /= sum;
+        ready = true;
+    }
+    double u = (double)(nextRandom(seed) >> 11) / 9007199254740992.0;
+    size_t lo = 0, hi = ZIPF_VALUES - 1;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (cdf[mid] < u) lo = mid + 1; else hi = mid;
+    }
+    return (int)(((unsigned)lo * 2654435761u) >> 1);
+}
+
+void fillInput(int *arr, size_t size, InputKind kind, unsigned long long seed) {
+    for (size_t i = 0; i < size; i++) {
+        switch (kind) {
+            case INPUT_RANDOM:     arr[i] = (int)(nextRandom(&seed) >> 33); break;
+            case INPUT_SORTED:     arr[i] = (int)i; break;
+            case INPUT_REVERSED:   arr[i] = (int)(size - i); break;
+            case INPUT_FEW_UNIQUE: arr[i] = (int)(nextRandom(&seed) % 16); break;
+            case INPUT_ORGAN_PIPE: arr[i] = (int)(i < size / 2 ? i : size - i); break;
+            case INPUT_ZIPF:       arr[i] = zipfValue(&seed); break;
+            default:               arr[i] = 0; break;
+        }
+    }
+}
+
+bool isSorted(const int *arr, size_t size) {
+    for (size_t i = 1; i < size; i++) {
+        if (arr[i] < arr[i - 1]) return false;
+    }
+    return true;
+}
+
+// Order-independent fingerprint: a sort must not change it
+unsigned long long checksum(const int *arr, size_t size) {
+    unsigned long long sum = 0;
+    for (size_t i = 0; i < size; i++) {
+        unsigned long long x = (unsigned long long)(unsigned)arr[i] * 0x9E3779B97F4A7C15ULL;
+        sum += x ^ (x >> 29);
+    }
+    return sum;
+}
+
+// ===== Parallel scaling =====
+
+void benchmarkParallel(size_t size, int max_threads) {
+    printf("Parallel Merge Sort (%zu ints):\n", size);
+    int *input = (int*)malloc(size * sizeof(int));
+    int *arr = (int*)malloc(size * sizeof(int));
+
+    printf("   %-11s %8s", "input", "1 thr");
+    for (int threads = 2; threads <= max_threads; threads *= 2) printf("   %5d thr", threads);
+    printf("\n");
+
+    for (int kind = 0; kind < INPUT_KINDS; kind++) {
+        fillInput(input, size, (InputKind)kind, 42);
+        unsigned long long expected = checksum(input, size);
+        double single = 0;
+        bool ok = true;
+        printf("   %-11s", input_names[kind]);
+
+        for (int threads = 1; threads <= max_threads; threads *= 2) {
+            // Pool startup is not part of the sort
+            SortPool *pool = createSortPool(threads);
+            memcpy(arr, input, size * sizeof(int));
+            double start = nowSeconds();
+            parallelMergeSortInt(pool, arr, size);
+            double t = nowSeconds() - start;
+            freeSortPool(pool);
+
+            ok = ok && isSorted(arr, size) && checksum(arr, size) == expected;
+            if (threads == 1) {
+                single = t;
+                printf(" %7.3f s", t);
+            } else {
+                printf(" %6.3f s %4.1fx", t, single / t);
+            }
+        }
+        printf("  %s\n", ok ? "OK" : "MISMATCH");
+    }
+    printf("\n");
+    free(arr);
+    free(input);
+}
+
+// ===== Searching =====
+
+// The textbook search from array_algorithms.c, as the baseline
+static int binarySearch(const int *arr, int size, int target) {
+    int left = 0, right = size - 1;
+    while (left <= right) {
+        int mid = left + (right - left) / 2;
+        if (arr[mid] == target) {
+            return mid;
+        } else if (arr[mid] < target) {
+            left = mid + 1;
+        } else {
+            right = mid - 1;
+        }
+    }
+    return -1;
+}
+
+// Arrays from L1-sized to far beyond the last-level cache, each holding
+// the even numbers 0, 2, 4, ...; half of the random keys are misses
+void benchmarkSearch(size_t max_size, size_t num_keys) {
+    printf("Binary Search (%zu random keys, ns per lookup):\n", num_keys);
+    printf("   %11s %10s %14s %12s %10s\n", "elements", "KiB", "binarySearch", "branchless",
+           "batched");
+
+    int *arr = (int*)malloc(max_size * sizeof(int));
+    int *keys = (int*)malloc(num_keys * sizeof(int));
+    size_t *positions = (size_t*)malloc(num_keys * sizeof(size_t));
+    for (size_t i = 0; i < max_size; i++) arr[i] = (int)(2 * i);
+
+    for (size_t size = 1024; size <= max_size; size *= 4) {
+        unsigned long long seed = 7;
+        for (size_t k = 0; k < num_keys; k++) keys[k] = (int)(nextRandom(&seed) % (2 * size));
+
+        // The sums keep the compiler from dropping the searches
+        long long sum_classic = 0, sum_branchless = 0;
+        double start = nowSeconds();
+        for (size_t k = 0; k < num_keys; k++) sum_classic += binarySearch(arr, (int)size, keys[k]);
+        double t_classic = nowSeconds() - start;
+
+        start = nowSeconds();
+        for (size_t k = 0; k < num_keys; k++) sum_branchless += lowerBoundInt(arr, size, keys[k]);
+        double t_branchless = nowSeconds() - start;
+
+        start = nowSeconds();
+        lowerBoundBatchInt(arr, size, keys, num_keys, positions);
+        double t_batched = nowSeconds() - start;
+
+        // Same answers: a hit at the same index, or a miss
+        bool ok = true;
+        long long sum_batched = 0;
+        for (size_t k = 0; k < num_keys && ok; k++) {
+            size_t pos = positions[k];
+            sum_batched += pos;
+            int expected = binarySearch(arr, (int)size, keys[k]);
+            bool hit = pos < size && arr[pos] == keys[k];
+            ok = (hit ? (int)pos : -1) == expected;
+        }
+        ok = ok && sum_batched == sum_branchless;
+
+        printf("   %11zu %10zu %11.1f ns %9.1f ns %7.1f ns  %s\n", size,
+               size * sizeof(int) / 1024, t_classic * 1e9 / num_keys,
+               t_branchless * 1e9 / num_keys, t_batched * 1e9 / num_keys,
+               ok && sum_classic != 0 ? "OK" : "MISMATCH");
+    }
+    printf("\n");
+    free(positions);
+    free(keys);
+    free(arr);
+}
+
+// ===== SIMD scans =====
+
+// Each kernel streams the whole array (the search key is absent), so
+// GB/s shows how close each instruction set gets to memory bandwidth
+void benchmarkScan(size_t size, int repeats) {
+    SimdLevel best = simdDetect();
+    printf("SIMD Scans (%zu ints, %zu MiB, best of %d, GB/s):\n", size,
+           size * sizeof(int) >> 20, repeats);
+    printf("   %-8s %14s %10s %10s\n", "level", "linearSearch", "findMax", "reverse");
+
+    int *arr = (int*)malloc((size > 0 ? size : 1) * sizeof(int));
+    fillInput(arr, size, INPUT_RANDOM, 42);    // Non-negative, so -1 is never found
+    double bytes = (double)size * sizeof(int);
+
+    long long expected_pos = -1;
+    int expected_max = 0;
+    for (int level = SIMD_SCALAR; level <= (int)best; level++) {
+        simdSelect((SimdLevel)level);
+        double t_search = 1e30, t_max = 1e30, t_reverse = 1e30;
+        long long pos = 0;
+        int max = 0;
+        for (int r = 0; r < repeats; r++) {
+            double start = nowSeconds();
+            pos = linearSearchSimd(arr, size, -1);
+            double t = nowSeconds() - start;
+            if (t < t_search) t_search = t;
+
+            start = nowSeconds();
+            max = findMaxSimd(arr, size);
+            t = nowSeconds() - start;
+            if (t < t_max) t_max = t;
+
+            // Reversal reads and writes every byte
+            start = nowSeconds();
+            reverseArraySimd(arr, size);
+            t = nowSeconds() - start;
+            if (t < t_reverse) t_reverse = t;
+        }
+        // An even number of reversals leaves the array as it was
+        if (repeats % 2 != 0) reverseArraySimd(arr, size);
+
+        if (level == SIMD_SCALAR) {
+            expected_pos = pos;
+            expected_max = max;
+        }
+        bool ok = pos == expected_pos && max == expected_max;
+        printf("   %-8s %14.2f %10.2f %10.2f  %s\n", simdLevelName((SimdLevel)level),
+               bytes / t_search * 1e-9, bytes / t_max * 1e-9, 2 * bytes / t_reverse * 1e-9,
+               ok ? "OK" : "MISMATCH");
+    }
+    simdSelect(best);
+
+    // Odd sizes exercise every tail path: every level must agree exactly
+    // with the scalar loop, including the position of the first match
+    int copy[256];
+    bool ok = true;
+    for (size_t n = 0; n <= 256 && n <= size; n++) {
+        int target = n > 0 ? arr[n / 2] : 0;
+        simdSelect(SIMD_SCALAR);
+        long long expected_first = linearSearchSimd(arr, n, target);
+        int expected_largest = findMaxSimd(arr, n);
+        for (int level = SIMD_SSE2; level <= (int)best; level++) {
+            simdSelect((SimdLevel)level);
+            ok = ok && linearSearchSimd(arr, n, target) == expected_first;
+            ok = ok && findMaxSimd(arr, n) == expected_largest;
+            memcpy(copy, arr, n * sizeof(int));
+            reverseArraySimd(copy, n);
+            for (size_t i = 0; i < n; i++) ok = ok && copy[i] == arr[n - 1 - i];
+        }
+    }
+    simdSelect(best);
+    printf("   sizes 0..256: %s\n\n", ok ? "OK" : "MISMATCH");
+    free(arr);
+}
+
+// ===== Selection =====
+
+// p50, p99 and p99.9 three ways: sort and index, introselect in place,
+// and the pool's sample-and-count pass, which leaves the input alone
+void benchmarkSelect(size_t size, int threads) {
+    const double quantiles[] = { 0.5, 0.99, 0.999 };
+    printf("Quantiles p50/p99/p99.9 (%zu ints, %d threads):\n", size, threads);
+    if (size == 0) {
+        printf("   No elements, skipped\n\n");
+        return;
+    }
+    printf("   %-11s %11s %13s %11s\n", "input", "introSort", "quantilesInt", "parallel");
+
+    int *input = (int*)malloc(size * sizeof(int));
+    int *arr = (int*)malloc(size * sizeof(int));
+    SortPool *pool = createSortPool(threads);
+
+    for (int kind = 0; kind < INPUT_KINDS; kind++) {
+        fillInput(input, size, (InputKind)kind, 42);
+        int sorted_out[3], select_out[3], parallel_out[3];
+
+        memcpy(arr, input, size * sizeof(int));
+        double start = nowSeconds();
+        introSortInt(arr, size);
+        for (int q = 0; q < 3; q++) sorted_out[q] = arr[quantileRank(size, quantiles[q])];
+        double t_sort = nowSeconds() - start;
+
+        memcpy(arr, input, size * sizeof(int));
+        start = nowSeconds();
+        quantilesInt(arr, size, quantiles, 3, select_out);
+        double t_select = nowSeconds() - start;
+
+        start = nowSeconds();
+        parallelQuantilesInt(pool, input, size, quantiles, 3, parallel_out);
+        double t_parallel = nowSeconds() - start;
+
+        bool ok = true;
+        for (int q = 0; q < 3; q++) {
+            ok = ok && select_out[q] == sorted_out[q] && parallel_out[q] == sorted_out[q];
+        }
+        printf("   %-11s %9.3f s %11.3f s %9.3f s  %s\n", input_names[kind], t_sort, t_select,
+               t_parallel, ok ? "OK" : "MISMATCH");
+    }
+    printf("\n");
+    freeSortPool(pool);
+    free(arr);
+    free(input);
+}
+
+// ===== Substring search =====
+
+// countOccurrences() from advanced_strings.c with explicit lengths
+static size_t countNaive(const char *text, size_t n, const char *pattern, size_t m) {
+    size_t count = 0;
+    for (size_t i = 0; i + m <= n; i++) {
+        size_t j;
+        for (j = 0; j < m; j++) {
+            if (text[i + j] != pattern[j]) break;
+        }
+        if (j == m) count++;
+    }
+    return count;
+}
+
+static void compareSubstring(const char *label, const char *text, size_t n, const char *pattern,
+                             size_t m) {
+    double start = nowSeconds();
+    size_t naive = countNaive(text, n, pattern, m);
+    double t_naive = nowSeconds() - start;
+
+    StringSearcher *searcher = createStringSearcher(pattern, m);
+    start = nowSeconds();
+    size_t count = searcherFindAll(searcher, text, n, NULL, 0);
+    double t_search = nowSeconds() - start;
+    freeStringSearcher(searcher);
+
+    printf("   %-10s %6zu %10zu %9.2f GB/s %9.2f GB/s  %s\n", label, m, count,
+           n / t_naive * 1e-9, n / t_search * 1e-9, count == naive ? "OK" : "MISMATCH");
+}
+
+// Random words over 26 letters, patterns cut from the text so they
+// occur; then a periodic text where naive matching and plain Horspool
+// compare half the pattern at every position
+void benchmarkSubstring(size_t size) {
+    printf("Substring Search (%zu MiB text, counting every match):\n", size >> 20);
+    printf("   %-10s %6s %10s %14s %14s\n", "text", "length", "matches", "naive", "searcher");
+
+    char *text = (char*)malloc(size > 0 ? size : 1);
+    unsigned long long seed = 42;
+    for (size_t i = 0; i < size; i++) {
+        unsigned r = (unsigned)(nextRandom(&seed) >> 40) % 32;
+        text[i] = r < 26 ? (char)('a' + r) : ' ';
+    }
+    const size_t lengths[] = { 2, 4, 8, 16, 32, 64, 256, 1024 };
+    for (size_t i = 0; i < sizeof(lengths) / sizeof(lengths[0]); i++) {
+        if (lengths[i] > size) break;
+        size_t at = (size_t)(nextRandom(&seed) % (size - lengths[i] + 1));
+        compareSubstring("words", text, size, text + at, lengths[i]);
+    }
+
+    size_t periodic_size = size < (16 << 20) ? size : 16 << 20;
+    memset(text, 'a', periodic_size);
+    char pattern[64];
+    memset(pattern, 'a', sizeof(pattern));
+    pattern[32] = 'b';
+    if (periodic_size >= sizeof(pattern)) {
+        compareSubstring("aaaa...", text, periodic_size, pattern, sizeof(pattern));
+    }
+    printf("\n");
+    free(text);
+}
+
+// ===== Multi-pattern search =====
+
+#define MULTI_SLICE (256 << 10)     // Text searched once per keyword
+#define MULTI_CHUNK (64 << 10)      // Buffer size for the streaming run
+
+typedef struct {
+    size_t count;
+    unsigned long long checksum;
+} MatchTally;
+
+static bool tallyMatch(void *context, int pattern, size_t offset) {
+    MatchTally *tally = (MatchTally*)context;
+    tally->count++;
+    tally->checksum += ((unsigned long long)pattern << 40) ^ offset;
+    return true;
+}
+
+// Log-like text (words over 26 letters, a newline every ~80 bytes) and
+// num_patterns keywords of 4-16 bytes cut from it. A searcher per
+// keyword scans the text num_patterns times, so it only gets a slice;
+// the automaton scans everything once, in one buffer and then streamed
+// in chunks, which must find exactly the same matches.
+void benchmarkMultiPattern(size_t size, size_t num_patterns) {
+    if (size < MULTI_SLICE) size = MULTI_SLICE;
+    printf("Multi-pattern Search (%zu keywords, %zu MiB text):\n", num_patterns, size >> 20);
+
+    char *text = (char*)malloc(size);
+    unsigned long long seed = 42;
+    for (size_t i = 0; i < size; i++) {
+        unsigned r = (unsigned)(nextRandom(&seed) >> 40) % 32;
+        text[i] = r < 26 ? (char)('a' + r) : r < 31 ? ' ' : '\n';
+    }
+    char **patterns = (char**)malloc(num_patterns * sizeof(char*));
+    size_t *lengths = (size_t*)malloc(num_patterns * sizeof(size_t));
+    for (size_t p = 0; p < num_patterns; p++) {
+        lengths[p] = 4 + (size_t)(nextRandom(&seed) % 13);
+        patterns[p] = text + nextRandom(&seed) % (MULTI_SLICE - lengths[p] + 1);
+    }
+
+    double start = nowSeconds();
+    AhoCorasick *automaton = createAhoCorasick((const char *const*)patterns, lengths,
+                                               num_patterns);
+    printf("   Build: %zu states in %.3f s\n", acNumStates(automaton), nowSeconds() - start);
+    printf("   %-22s %10s %12s %12s\n", "method", "text", "matches", "throughput");
+
+    start = nowSeconds();
+    size_t per_pattern = 0;
+    for (size_t p = 0; p < num_patterns; p++) {
+        StringSearcher *searcher = createStringSearcher(patterns[p], lengths[p]);
+        per_pattern += searcherFindAll(searcher, text, MULTI_SLICE, NULL, 0);
+        freeStringSearcher(searcher);
+    }
+    double t_per_pattern = nowSeconds() - start;
+    printf("   %-22s %6d KiB %12zu %9.3f GB/s\n", "searcher per keyword", MULTI_SLICE >> 10,
+           per_pattern, MULTI_SLICE / t_per_pattern * 1e-9);
+
+    start = nowSeconds();
+    size_t slice_count = acFindAll(automaton, text, MULTI_SLICE, NULL, 0);
+    double t_slice = nowSeconds() - start;
+    printf("   %-22s %6d KiB %12zu %9.3f GB/s  %s\n", "aho-corasick", MULTI_SLICE >> 10,
+           slice_count, MULTI_SLICE / t_slice * 1e-9, slice_count == per_pattern ? "OK" : "MISMATCH");
+
+    MatchTally whole = { 0, 0 };
+    AcStream stream;
+    acStreamInit(&stream, automaton);
+    start = nowSeconds();
+    acStreamFeed(&stream, text, size, tallyMatch, &whole);
+    double t_whole = nowSeconds() - start;
+    printf("   %-22s %6zu MiB %12zu %9.3f GB/s\n", "aho-corasick", size >> 20, whole.count,
+           size / t_whole * 1e-9);
+
+    MatchTally chunked = { 0, 0 };
+    acStreamInit(&stream, automaton);
+    start = nowSeconds();
+    for (size_t offset = 0; offset < size; offset += MULTI_CHUNK) {
+        size_t length = size - offset < MULTI_CHUNK ? size - offset : MULTI_CHUNK;
+        acStreamFeed(&stream, text + offset, length, tallyMatch, &chunked);
+    }
+    double t_chunked = nowSeconds() - start;
+    bool same = chunked.count == whole.count && chunked.checksum == whole.checksum;
+    printf("   %-22s %6zu MiB %12zu %9.3f GB/s  %s\n", "streamed, 64 KiB chunks", size >> 20,
+           chunked.count, size / t_chunked * 1e-9, same ? "OK" : "MISMATCH");
+    printf("\n");
+
+    freeAhoCorasick(automaton);
+    free(lengths);
+    free(patterns);
+    free(text);
+}
+
+// ===== Sort suite =====
+// Every sort on every input pattern, size and element type, printed as
+// a table, CSV or JSON. The textbook sorts are copies of the ones in
+// array_algorithms.c and heap_priority_queue.c (module 12), so they can
+// be measured next to the library on the same inputs.
+
+#define QUADRATIC_LIMIT (1 << 14)   // Largest input for bubble and selection sort
+#define SUITE_MIN_TIME 0.02         // Small inputs are re-sorted for at least this long
+
+static void bubbleSort(int arr[], int size) {
+    for (int i = 0; i < size - 1; i++) {
+        for (int j = 0; j < size - i - 1; j++) {
+            if (arr[j] > arr[j + 1]) {
+                int temp = arr[j];
+                arr[j] = arr[j + 1];
+                arr[j + 1] = temp;
+            }
+        }
+    }
+}
+
+static void selectionSort(int arr[], int size) {
+    for (int i = 0; i < size - 1; i++) {
+        int min_idx = i;
+        for (int j = i + 1; j < size; j++) {
+            if (arr[j] < arr[min_idx]) {
+                min_idx = j;
+            }
+        }
+        int temp = arr[min_idx];
+        arr[min_idx] = arr[i];
+        arr[i] = temp;
+    }
+}
+
+// The module 12 heap sort: copy into a separate max-heap, heapify, then
+// extract the root into arr from the back
+static void heapSiftDown(int *heap, int size, int index) {
+    while (true) {
+        int target = index;
+        int left = 2 * index + 1;
+        int right = 2 * index + 2;
+        if (left < size && heap[left] > heap[target]) target = left;
+        if (right < size && heap[right] > heap[target]) target = right;
+        if (target == index) break;
+        int temp = heap[index];
+        heap[index] = heap[target];
+        heap[target] = temp;
+        index = target;
+    }
+}
+
+static void heapSort(int arr[], int n) {
+    int *heap = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    memcpy(heap, arr, n * sizeof(int));
+    for (int i = n / 2 - 1; i >= 0; i--) heapSiftDown(heap, n, i);
+    for (int i = n - 1, size = n; i >= 0; i--) {
+        arr[i] = heap[0];
+        heap[0] = heap[--size];
+        heapSiftDown(heap, size, 0);
+    }
+    free(heap);
+}
+
+static SortPool *suite_pool;
+
+static int compareInt(const void *a, const void *b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static void runIntroSortInt(void *arr, size_t size) { introSortInt((int*)arr, size); }
+static void runParallelMergeSort(void *arr, size_t size) {
+    parallelMergeSortInt(suite_pool, (int*)arr, size);
+}
+static void runQsortInt(void *arr, size_t size) { qsort(arr, size, sizeof(int), compareInt); }
+static void runHeapSort(void *arr, size_t size) { heapSort((int*)arr, (int)size); }
+static void runBubbleSort(void *arr, size_t size) { bubbleSort((int*)arr, (int)size); }
+static void runSelectionSort(void *arr, size_t size) { selectionSort((int*)arr, (int)size); }
+
+static bool isSortedIntVoid(const void *arr, size_t size) { return isSorted((const int*)arr, size); }
+
+// Inputs are generated as ints at the front of the buffer and widened in
+// place, back to front, so the wider types need no second array.
+// memcpy keeps the overlapping int and T accesses well defined.
+#define DEFINE_ELEMENT_TYPE(T, Suffix)                                              \
+    static void widen##Suffix(void *arr, size_t size) {                             \
+        for (size_t i = size; i-- > 0;) {                                           \
+            int value;                                                              \
+            memcpy(&value, (char*)arr + i * sizeof(int), sizeof(int));              \
+            T wide = (T)value;                                                      \
+            memcpy((char*)arr + i * sizeof(T), &wide, sizeof(T));                   \
+        }                                                                           \
+    }                                                                               \
+    static bool isSorted##Suffix(const void *arr, size_t size) {                    \
+        const T *a = (const T*)arr;                                                 \
+        for (size_t i = 1; i < size; i++) {                                         \
+            if (a[i] < a[i - 1]) return false;                                      \
+        }                                                                           \
+        return true;                                                                \
+    }                                                                               \
+    static int compare##Suffix(const void *a, const void *b) {                      \
+        T x = *(const T*)a, y = *(const T*)b;                                       \
+        return (x > y) - (x < y);                                                   \
+    }                                                                               \
+    static void runIntroSort##Suffix(void *arr, size_t size) {                      \
+        introSort##Suffix((T*)arr, size);                                           \
+    }                                                                               \
+    static void runQsort##Suffix(void *arr, size_t size) {                          \
+        qsort(arr, size, sizeof(T), compare##Suffix);                               \
+    }
+
+DEFINE_ELEMENT_TYPE(int64_t, Int64)
+DEFINE_ELEMENT_TYPE(float, Float)
+DEFINE_ELEMENT_TYPE(double, Double)
+
+typedef struct {
+    const char *name;
+    void (*sort)(void *arr, size_t size);
+    size_t max_size;                // 0: any size
+    bool parallel;
+} Sorter;
+
+#define SUITE_SORTERS 6
+
+typedef struct {
+    const char *name;
+    size_t elem_size;
+    void (*widen)(void *arr, size_t size);      // NULL for int
+    bool (*is_sorted)(const void *arr, size_t size);
+    Sorter sorters[SUITE_SORTERS];              // Ends at the first NULL name
+} ElementType;
+
+static const ElementType element_types[] = {
+    { "int", sizeof(int), NULL, isSortedIntVoid, {
+        { "introSort", runIntroSortInt, 0, false },
+        { "parallelMergeSort", runParallelMergeSort, 0, true },
+        { "qsort", runQsortInt, 0, false },
+        { "heapSort", runHeapSort, (size_t)INT32_MAX, false },
+        { "bubbleSort", runBubbleSort, QUADRATIC_LIMIT, false },
+        { "selectionSort", runSelectionSort, QUADRATIC_LIMIT, false } } },
+    { "int64", sizeof(int64_t), widenInt64, isSortedInt64, {
+        { "introSort", runIntroSortInt64, 0, false },
+        { "qsort", runQsortInt64, 0, false } } },
+    { "float", sizeof(float), widenFloat, isSortedFloat, {
+        { "introSort", runIntroSortFloat, 0, false },
+        { "qsort", runQsortFloat, 0, false } } },
+    { "double", sizeof(double), widenDouble, isSortedDouble, {
+        { "introSort", runIntroSortDouble, 0, false },
+        { "qsort", runQsortDouble, 0, false } } },
+};
+
+typedef enum {
+    FORMAT_TABLE,
+    FORMAT_CSV,
+    FORMAT_JSON
+} OutputFormat;
+
+// checksum() for elements of any width
+static unsigned long long checksumBytes(const void *arr, size_t size, size_t elem_size) {
+    unsigned long long sum = 0;
+    for (size_t i = 0; i < size; i++) {
+        unsigned long long bits = 0;
+        memcpy(&bits, (const char*)arr + i * elem_size, elem_size);
+        unsigned long long x = bits * 0x9E3779B97F4A7C15ULL;
+        sum += x ^ (x >> 29);
+    }
+    return sum;
+}
+
+static void printSuiteRow(OutputFormat format, bool first, const char *type, const char *input,
+                          size_t size, const char *algorithm, int threads, double seconds,
+                          bool ok) {
+    double ns = seconds * 1e9 / (double)size;
+    switch (format) {
+        case FORMAT_CSV:
+            printf("%s,%s,%zu,%s,%d,%.9f,%.3f,%s\n", type, input, size, algorithm, threads,
+                   seconds, ns, ok ? "true" : "false");
+            break;
+        case FORMAT_JSON:
+            printf("%s  {\"type\": \"%s\", \"input\": \"%s\", \"size\": %zu, \"algorithm\": \"%s\", "
+                   "\"threads\": %d, \"seconds\": %.9f, \"ns_per_element\": %.3f, \"ok\": %s}",
+                   first ? "" : ",\n", type, input, size, algorithm, threads, seconds, ns,
+                   ok ? "true" : "false");
+            break;
+        default:
+            printf("   %-7s %-11s %11zu %-18s %3d %12.6f s %9.2f ns  %s\n", type, input, size,
+                   algorithm, threads, seconds, ns, ok ? "OK" : "MISMATCH");
+            break;
+    }
+}
+
+// Sizes 1Ki, 4Ki, 16Ki, ... up to max_size (1Gi for a billion elements)
+void benchmarkSuite(size_t max_size, int threads, OutputFormat format) {
+    suite_pool = createSortPool(threads);
+    void *arr = malloc((max_size > 0 ? max_size : 1) * sizeof(double));
+
+    if (format == FORMAT_CSV) {
+        printf("type,input,size,algorithm,threads,seconds,ns_per_element,ok\n");
+    } else if (format == FORMAT_JSON) {
+        printf("[\n");
+    } else {
+        printf("Sort Suite (up to %zu elements, seconds per sort):\n", max_size);
+        printf("   %-7s %-11s %11s %-18s %3s %14s %12s\n", "type", "input", "size", "algorithm",
+               "thr", "time", "per elem");
+    }
+
+    bool first = true;
+    for (size_t t = 0; t < sizeof(element_types) / sizeof(element_types[0]); t++) {
+        const ElementType *type = &element_types[t];
+        for (int kind = 0; kind < INPUT_KINDS; kind++) {
+            for (size_t size = 1024; size <= max_size; size *= 4) {
+                for (int s = 0; s < SUITE_SORTERS && type->sorters[s].name != NULL; s++) {
+                    const Sorter *sorter = &type->sorters[s];
+                    if (sorter->max_size != 0 && size > sorter->max_size) continue;
+
+                    double total = 0;
+                    int runs = 0;
+                    bool ok = true;
+                    do {
+                        fillInput((int*)arr, size, (InputKind)kind, 42);
+                        if (type->widen != NULL) type->widen(arr, size);
+                        unsigned long long expected = checksumBytes(arr, size, type->elem_size);
+                        double start = nowSeconds();
+                        sorter->sort(arr, size);
+                        total += nowSeconds() - start;
+                        runs++;
+                        ok = ok && type->is_sorted(arr, size) &&
+                             checksumBytes(arr, size, type->elem_size) == expected;
+                    } while (total < SUITE_MIN_TIME);
+
+                    printSuiteRow(format, first, type->name, input_names[kind], size, sorter->name,
+                                  sorter->parallel ? threads : 1, total / runs, ok);
+                    first = false;
+                }
+            }
+        }
+    }
+
+    if (format == FORMAT_JSON) printf("\n]\n");
+    else if (format == FORMAT_TABLE) printf("\n");
+    free(arr);
+    freeSortPool(suite_pool);
+}
+
+int main(int argc, char *argv[]) {
+    const char *which = argc > 1 ? argv[1] : "parallel";
+    size_t size = argc > 2 ? (size_t)atoll(argv[2]) : 10000000;
+    int max_threads = argc > 3 ? atoi(argv[3]) : 4;
+    if (max_threads < 1) max_threads = 1;
+
+    // CSV and JSON output must stay machine-readable: no banner
+    const char *format_name = argc > 4 ? argv[4] : "table";
+    OutputFormat format = strcmp(format_name, "csv") == 0  ? FORMAT_CSV
+                        : strcmp(format_name, "json") == 0 ? FORMAT_JSON
+                                                           : FORMAT_TABLE;
+    if (format == FORMAT_TABLE) printf("=== Sort Benchmarks ===\n\n");
+
+    if (strcmp(which, "parallel") == 0) {
+        benchmarkParallel(size, max_threads);
+    } else if (strcmp(which, "search") == 0) {
+        benchmarkSearch(argc > 2 ? size : 64 << 20, 1 << 20);
+    } else if (strcmp(which, "scan") == 0) {
+        benchmarkScan(argc > 2 ? size : 64 << 20, 5);
+    } else if (strcmp(which, "select") == 0) {
+        benchmarkSelect(size, max_threads);
+    } else if (strcmp(which, "substring") == 0) {
+        benchmarkSubstring(argc > 2 ? size : 256 << 20);
+    } else if (strcmp(which, "multi") == 0) {
+        benchmarkMultiPattern(argc > 2 ? size : 256 << 20, 10000);
+    } else if (strcmp(which, "suite") == 0) {
+        benchmarkSuite(argc > 2 ? size : 1 << 20, max_threads, format);
+    } else {
+        printf("Unknown benchmark '%s'\n", which);
+        printf("Usage: ./sort_benchmark [parallel|search|scan|select|substring|multi|suite] "
+               "[size] [max_threads] [table|csv|json]\n");
+        return 1;
+    }
+    return 0;
+}
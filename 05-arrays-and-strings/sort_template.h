@@ -0,0 +1,417 @@
+/*
+ * sort_template.h
+ * pdqsort and introselect for one element type, included once per type
+ * by sorting.c
+ *
+ * Before including, define:
+ *     SORT_TYPE    element type, ordered by <
+ *     SORT_SUFFIX  appended to every function name (Int, Double, ...)
+ * Both are undefined again at the end of this file.
+ */
+
+#define SORT_CONCAT_(a, b) a##b
+#define SORT_CONCAT(a, b) SORT_CONCAT_(a, b)
+#define SORT_FN(name) SORT_CONCAT(name, SORT_SUFFIX)
+
+static inline void SORT_FN(swap)(SORT_TYPE *a, SORT_TYPE *b) {
+    SORT_TYPE tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+// Order *a <= *b <= *c
+static inline void SORT_FN(sort3)(SORT_TYPE *a, SORT_TYPE *b, SORT_TYPE *c) {
+    if (*b < *a) SORT_FN(swap)(a, b);
+    if (*c < *b) SORT_FN(swap)(b, c);
+    if (*b < *a) SORT_FN(swap)(a, b);
+}
+
+static void SORT_FN(insertionSort)(SORT_TYPE *begin, SORT_TYPE *end) {
+    if (begin == end) return;
+    for (SORT_TYPE *cur = begin + 1; cur != end; cur++) {
+        SORT_TYPE *sift = cur;
+        SORT_TYPE *sift_1 = cur - 1;
+        if (*sift < *sift_1) {
+            SORT_TYPE tmp = *sift;
+            do {
+                *sift-- = *sift_1;
+            } while (sift != begin && tmp < *--sift_1);
+            *sift = tmp;
+        }
+    }
+}
+
+// Same, for a range whose left neighbor begin[-1] is no larger than any
+// element in it: the sentinel stops the scan, so no bounds check
+static void SORT_FN(unguardedInsertionSort)(SORT_TYPE *begin, SORT_TYPE *end) {
+    if (begin == end) return;
+    for (SORT_TYPE *cur = begin + 1; cur != end; cur++) {
+        SORT_TYPE *sift = cur;
+        SORT_TYPE *sift_1 = cur - 1;
+        if (*sift < *sift_1) {
+            SORT_TYPE tmp = *sift;
+            do {
+                *sift-- = *sift_1;
+            } while (tmp < *--sift_1);
+            *sift = tmp;
+        }
+    }
+}
+
+// Insertion sort that gives up once it has moved more than
+// SORT_PARTIAL_LIMIT elements; returns true if the range got sorted
+static bool SORT_FN(partialInsertionSort)(SORT_TYPE *begin, SORT_TYPE *end) {
+    if (begin == end) return true;
+    size_t moved = 0;
+    for (SORT_TYPE *cur = begin + 1; cur != end; cur++) {
+        SORT_TYPE *sift = cur;
+        SORT_TYPE *sift_1 = cur - 1;
+        if (*sift < *sift_1) {
+            SORT_TYPE tmp = *sift;
+            do {
+                *sift-- = *sift_1;
+            } while (sift != begin && tmp < *--sift_1);
+            *sift = tmp;
+            moved += (size_t)(cur - sift);
+        }
+        if (moved > SORT_PARTIAL_LIMIT) return false;
+    }
+    return true;
+}
+
+static void SORT_FN(siftDown)(SORT_TYPE *heap, size_t size, size_t root) {
+    SORT_TYPE value = heap[root];
+    while (2 * root + 1 < size) {
+        size_t child = 2 * root + 1;
+        if (child + 1 < size && heap[child] < heap[child + 1]) child++;
+        if (!(value < heap[child])) break;
+        heap[root] = heap[child];
+        root = child;
+    }
+    heap[root] = value;
+}
+
+static void SORT_FN(heapSort)(SORT_TYPE *begin, SORT_TYPE *end) {
+    size_t size = (size_t)(end - begin);
+    for (size_t i = size / 2; i-- > 0;) {
+        SORT_FN(siftDown)(begin, size, i);
+    }
+    for (size_t i = size; i-- > 1;) {
+        SORT_FN(swap)(&begin[0], &begin[i]);
+        SORT_FN(siftDown)(begin, i, 0);
+    }
+}
+
+// Swap num misplaced pairs; with unequal counts a cyclic rotation does
+// the same with one move per element instead of three
+static inline void SORT_FN(swapOffsets)(SORT_TYPE *first, SORT_TYPE *last,
+                                        const unsigned char *offsets_l,
+                                        const unsigned char *offsets_r,
+                                        size_t num, bool use_swaps) {
+    if (use_swaps) {
+        for (size_t i = 0; i < num; i++) {
+            SORT_FN(swap)(first + offsets_l[i], last - offsets_r[i]);
+        }
+    } else if (num > 0) {
+        SORT_TYPE *l = first + offsets_l[0];
+        SORT_TYPE *r = last - offsets_r[0];
+        SORT_TYPE tmp = *l;
+        *l = *r;
+        for (size_t i = 1; i < num; i++) {
+            l = first + offsets_l[i];
+            *r = *l;
+            r = last - offsets_r[i];
+            *l = *r;
+        }
+        *r = tmp;
+    }
+}
+
+// Partition around the pivot *begin: elements < pivot to the left,
+// >= pivot to the right. Returns the pivot's final position and whether
+// the range needed no swaps at all.
+static SORT_TYPE* SORT_FN(partitionRight)(SORT_TYPE *begin, SORT_TYPE *end,
+                                          bool *already_partitioned) {
+    SORT_TYPE pivot = *begin;
+    SORT_TYPE *first = begin;
+    SORT_TYPE *last = end;
+
+    // The median-of-3 left an element >= pivot at the end, so this
+    // scan stops; the second one needs a guard only if nothing smaller
+    // than the pivot was found on the left
+    while (*++first < pivot) {}
+    if (first - 1 == begin) {
+        while (first < last && !(*--last < pivot)) {}
+    } else {
+        while (!(*--last < pivot)) {}
+    }
+
+    *already_partitioned = first >= last;
+    if (!*already_partitioned) {
+        SORT_FN(swap)(first, last);
+        first++;
+
+        // Record offsets of misplaced elements a block at a time: the
+        // loop body has no data-dependent branch, only an add of a
+        // comparison result. Offsets are relative to base_l / base_r,
+        // which stay put until their side's offsets are used up.
+        unsigned char offsets_l[SORT_BLOCK];
+        unsigned char offsets_r[SORT_BLOCK];
+        SORT_TYPE *base_l = first;
+        SORT_TYPE *base_r = last;
+        size_t num_l = 0, num_r = 0, start_l = 0, start_r = 0;
+
+        while (first < last) {
+            // Split what is left between the sides that need offsets
+            size_t unknown = (size_t)(last - first);
+            size_t left_split = num_l == 0 ? (num_r == 0 ? unknown / 2 : unknown) : 0;
+            size_t right_split = num_r == 0 ? unknown - left_split : 0;
+            if (left_split > SORT_BLOCK) left_split = SORT_BLOCK;
+            if (right_split > SORT_BLOCK) right_split = SORT_BLOCK;
+
+            for (size_t i = 0; i < left_split; i++) {
+                offsets_l[num_l] = (unsigned char)i;
+                num_l += !(*first++ < pivot);
+            }
+            for (size_t i = 0; i < right_split; i++) {
+                offsets_r[num_r] = (unsigned char)(i + 1);
+                num_r += *--last < pivot;
+            }
+
+            size_t num = num_l < num_r ? num_l : num_r;
+            SORT_FN(swapOffsets)(base_l, base_r, offsets_l + start_l, offsets_r + start_r,
+                                 num, num_l == num_r);
+            num_l -= num;
+            num_r -= num;
+            start_l += num;
+            start_r += num;
+            if (num_l == 0) {
+                start_l = 0;
+                base_l = first;
+            }
+            if (num_r == 0) {
+                start_r = 0;
+                base_r = last;
+            }
+        }
+
+        // One side may still hold misplaced elements: move them across
+        if (num_l) {
+            while (num_l--) SORT_FN(swap)(base_l + offsets_l[start_l + num_l], --last);
+            first = last;
+        }
+        if (num_r) {
+            while (num_r--) SORT_FN(swap)(base_r - offsets_r[start_r + num_r], first++);
+            last = first;
+        }
+    }
+
+    SORT_TYPE *pivot_pos = first - 1;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return pivot_pos;
+}
+
+// Partition around *begin with elements equal to the pivot going left.
+// Used when the pivot equals the element before the range: then nothing
+// in the range is smaller, and all the equal keys are done in one pass.
+static SORT_TYPE* SORT_FN(partitionLeft)(SORT_TYPE *begin, SORT_TYPE *end) {
+    SORT_TYPE pivot = *begin;
+    SORT_TYPE *first = begin;
+    SORT_TYPE *last = end;
+
+    while (pivot < *--last) {}
+    if (last + 1 == end) {
+        while (first < last && !(pivot < *++first)) {}
+    } else {
+        while (!(pivot < *++first)) {}
+    }
+
+    while (first < last) {
+        SORT_FN(swap)(first, last);
+        while (pivot < *--last) {}
+        while (!(pivot < *++first)) {}
+    }
+
+    SORT_TYPE *pivot_pos = last;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+    return pivot_pos;
+}
+
+// After a badly unbalanced partition, swap a few elements of each side
+// with ones a quarter further in, to break up the pattern that fooled
+// the pivot choice
+static void SORT_FN(breakPatterns)(SORT_TYPE *begin, SORT_TYPE *pivot_pos, SORT_TYPE *end) {
+    size_t l_size = (size_t)(pivot_pos - begin);
+    size_t r_size = (size_t)(end - (pivot_pos + 1));
+    if (l_size >= SORT_INSERTION_THRESHOLD) {
+        SORT_FN(swap)(begin, begin + l_size / 4);
+        SORT_FN(swap)(pivot_pos - 1, pivot_pos - l_size / 4);
+        if (l_size > SORT_NINTHER_THRESHOLD) {
+            SORT_FN(swap)(begin + 1, begin + (l_size / 4 + 1));
+            SORT_FN(swap)(begin + 2, begin + (l_size / 4 + 2));
+            SORT_FN(swap)(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+            SORT_FN(swap)(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+        }
+    }
+    if (r_size >= SORT_INSERTION_THRESHOLD) {
+        SORT_FN(swap)(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+        SORT_FN(swap)(end - 1, end - r_size / 4);
+        if (r_size > SORT_NINTHER_THRESHOLD) {
+            SORT_FN(swap)(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+            SORT_FN(swap)(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+            SORT_FN(swap)(end - 2, end - (1 + r_size / 4));
+            SORT_FN(swap)(end - 3, end - (2 + r_size / 4));
+        }
+    }
+}
+
+// Recurse into the left part, loop on the right one. leftmost is false
+// when begin[-1] exists and is no larger than anything in the range.
+static void SORT_FN(pdqLoop)(SORT_TYPE *begin, SORT_TYPE *end, int bad_allowed, bool leftmost) {
+    while (true) {
+        size_t size = (size_t)(end - begin);
+        if (size < SORT_INSERTION_THRESHOLD) {
+            if (leftmost) {
+                SORT_FN(insertionSort)(begin, end);
+            } else {
+                SORT_FN(unguardedInsertionSort)(begin, end);
+            }
+            return;
+        }
+
+        // Pivot goes to *begin
+        size_t s2 = size / 2;
+        if (size > SORT_NINTHER_THRESHOLD) {
+            SORT_FN(sort3)(begin, begin + s2, end - 1);
+            SORT_FN(sort3)(begin + 1, begin + (s2 - 1), end - 2);
+            SORT_FN(sort3)(begin + 2, begin + (s2 + 1), end - 3);
+            SORT_FN(sort3)(begin + (s2 - 1), begin + s2, begin + (s2 + 1));
+            SORT_FN(swap)(begin, begin + s2);
+        } else {
+            SORT_FN(sort3)(begin + s2, begin, end - 1);
+        }
+
+        if (!leftmost && !(begin[-1] < *begin)) {
+            begin = SORT_FN(partitionLeft)(begin, end) + 1;
+            continue;
+        }
+
+        bool already_partitioned;
+        SORT_TYPE *pivot_pos = SORT_FN(partitionRight)(begin, end, &already_partitioned);
+        size_t l_size = (size_t)(pivot_pos - begin);
+        size_t r_size = (size_t)(end - (pivot_pos + 1));
+
+        if (l_size < size / 8 || r_size < size / 8) {
+            // Too many bad pivots: quicksort is going quadratic
+            if (--bad_allowed == 0) {
+                SORT_FN(heapSort)(begin, end);
+                return;
+            }
+
+            SORT_FN(breakPatterns)(begin, pivot_pos, end);
+        } else if (already_partitioned &&
+                   SORT_FN(partialInsertionSort)(begin, pivot_pos) &&
+                   SORT_FN(partialInsertionSort)(pivot_pos + 1, end)) {
+            // Input was (nearly) sorted already
+            return;
+        }
+
+        SORT_FN(pdqLoop)(begin, pivot_pos, bad_allowed, leftmost);
+        begin = pivot_pos + 1;
+        leftmost = false;
+    }
+}
+
+void SORT_FN(introSort)(SORT_TYPE *arr, size_t size) {
+    if (size < 2) return;
+    int bad_allowed = 0;
+    for (size_t n = size; n > 1; n >>= 1) bad_allowed++;
+    SORT_FN(pdqLoop)(arr, arr + size, bad_allowed, true);
+}
+
+// ===== Selection =====
+
+void SORT_FN(nthElement)(SORT_TYPE *arr, size_t size, size_t k);
+
+// Median of the medians of groups of five, at least 30% of the range
+// on either side of it: the worst-case pivot once quickselect keeps
+// choosing badly. The group medians are gathered at the front.
+static SORT_TYPE* SORT_FN(medianOfMedians)(SORT_TYPE *begin, SORT_TYPE *end) {
+    size_t groups = 0;
+    for (SORT_TYPE *group = begin; group < end; group += 5) {
+        SORT_TYPE *group_end = end - group > 5 ? group + 5 : end;
+        SORT_FN(insertionSort)(group, group_end);
+        SORT_FN(swap)(begin + groups, group + (group_end - group) / 2);
+        groups++;
+    }
+    SORT_FN(nthElement)(begin, groups, groups / 2);
+    return begin + groups / 2;
+}
+
+// Introselect: the pdqsort loop, continued only into the side that
+// holds nth. Bad partitions break up patterns as in pdqLoop; after
+// log2(n) of them the pivot comes from median of medians instead,
+// which keeps the worst case linear.
+void SORT_FN(nthElement)(SORT_TYPE *arr, size_t size, size_t k) {
+    if (k >= size) return;
+    int bad_allowed = 0;
+    for (size_t n = size; n > 1; n >>= 1) bad_allowed++;
+
+    SORT_TYPE *begin = arr, *end = arr + size, *nth = arr + k;
+    bool leftmost = true;
+    while ((size_t)(end - begin) >= SORT_INSERTION_THRESHOLD) {
+        size_t range = (size_t)(end - begin);
+        size_t s2 = range / 2;
+        if (bad_allowed <= 0) {
+            // Plenty of elements >= the median of medians follow it, so
+            // partitionRight's first scan still stops in the range
+            SORT_FN(swap)(begin, SORT_FN(medianOfMedians)(begin, end));
+        } else if (range > SORT_NINTHER_THRESHOLD) {
+            SORT_FN(sort3)(begin, begin + s2, end - 1);
+            SORT_FN(sort3)(begin + 1, begin + (s2 - 1), end - 2);
+            SORT_FN(sort3)(begin + 2, begin + (s2 + 1), end - 3);
+            SORT_FN(sort3)(begin + (s2 - 1), begin + s2, begin + (s2 + 1));
+            SORT_FN(swap)(begin, begin + s2);
+        } else {
+            SORT_FN(sort3)(begin + s2, begin, end - 1);
+        }
+
+        // Keys equal to begin[-1] are final: skip them in one pass
+        if (!leftmost && !(begin[-1] < *begin)) {
+            SORT_TYPE *pivot_pos = SORT_FN(partitionLeft)(begin, end);
+            if (nth <= pivot_pos) return;
+            begin = pivot_pos + 1;
+            continue;
+        }
+
+        bool already_partitioned;
+        SORT_TYPE *pivot_pos = SORT_FN(partitionRight)(begin, end, &already_partitioned);
+        size_t l_size = (size_t)(pivot_pos - begin);
+        size_t r_size = (size_t)(end - (pivot_pos + 1));
+        if (l_size < range / 8 || r_size < range / 8) {
+            bad_allowed--;
+            SORT_FN(breakPatterns)(begin, pivot_pos, end);
+        }
+
+        if (nth == pivot_pos) return;
+        if (nth < pivot_pos) {
+            end = pivot_pos;
+        } else {
+            begin = pivot_pos + 1;
+            leftmost = false;
+        }
+    }
+    if (leftmost) {
+        SORT_FN(insertionSort)(begin, end);
+    } else {
+        SORT_FN(unguardedInsertionSort)(begin, end);
+    }
+}
+
+#undef SORT_FN
+#undef SORT_CONCAT
+#undef SORT_CONCAT_
+#undef SORT_TYPE
+#undef SORT_SUFFIX
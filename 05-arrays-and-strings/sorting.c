@@ -0,0 +1,35 @@
+/*
+ * sorting.c
+ * Typed pattern-defeating quicksort and introselect
+ * Topics: introsort, branchless block partitioning, pivot selection,
+ *         type-generic code with the preprocessor
+ *
+ * The algorithm is written once in sort_template.h; each inclusion below
+ * stamps out a copy for one element type, so every comparison compiles
+ * to a single instruction instead of a call through a qsort comparator.
+ */
+
+#include <stdbool.h>
+#include "sorting.h"
+#include "selection.h"
+
+#define SORT_INSERTION_THRESHOLD 24     // Smaller ranges: insertion sort
+#define SORT_NINTHER_THRESHOLD 128      // Larger ranges: Tukey's ninther
+#define SORT_PARTIAL_LIMIT 8            // Moves before giving up on "nearly sorted"
+#define SORT_BLOCK 64                   // Offsets buffered per side (fits unsigned char)
+
+#define SORT_TYPE int
+#define SORT_SUFFIX Int
+#include "sort_template.h"
+
+#define SORT_TYPE int64_t
+#define SORT_SUFFIX Int64
+#include "sort_template.h"
+
+#define SORT_TYPE float
+#define SORT_SUFFIX Float
+#include "sort_template.h"
+
+#define SORT_TYPE double
+#define SORT_SUFFIX Double
+#include "sort_template.h"
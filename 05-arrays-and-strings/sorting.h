@@ -0,0 +1,37 @@
+/*
+ * sorting.h
+ * In-place O(n log n) sorting of plain arrays
+ *
+ * introSort*() - pattern-defeating quicksort (pdqsort):
+ *   - pivot is the median of 3, or Tukey's ninther above 128 elements
+ *   - ranges below 24 elements finish with insertion sort
+ *   - partitioning is branchless: elements on the wrong side are found
+ *     in blocks of 64, recording their offsets with arithmetic instead
+ *     of branches, then swapped in a second pass
+ *   - an already partitioned range gets a bounded insertion sort, so
+ *     sorted and nearly sorted input takes linear time
+ *   - runs of equal keys are split off in one pass
+ *   - after log2(n) badly unbalanced partitions the range falls back to
+ *     heapsort, which bounds the worst case at O(n log n)
+ *
+ * Sorting is ascending and not stable. Float and double arrays must not
+ * contain NaN.
+ */
+
+#ifndef SORTING_H
+#define SORTING_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * @brief Sort an array in ascending order
+ * @param arr Array to sort
+ * @param size Number of elements
+ */
+void introSortInt(int *arr, size_t size);
+void introSortInt64(int64_t *arr, size_t size);
+void introSortFloat(float *arr, size_t size);
+void introSortDouble(double *arr, size_t size);
+
+#endif /* SORTING_H */
@@ -0,0 +1,273 @@
+/*
+ * string_search.c
+ * SIMD-filtered, Horspool and Two-Way substring search
+ * Topics: bad-character shifts, critical factorization, SSE2 byte
+ *         comparison, worst-case guarantees
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include "string_search.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// Horspool may verify this many pattern bytes per text byte advanced
+// before handing over to Two-Way
+#define HORSPOOL_WORK_FACTOR 4
+
+typedef enum {
+    METHOD_EMPTY,
+    METHOD_BYTE,
+    METHOD_FILTER,
+    METHOD_HORSPOOL
+} SearchMethod;
+
+struct StringSearcher {
+    unsigned char *pattern;
+    size_t length;
+    SearchMethod method;
+
+    // Horspool: how far the window may move when its last text byte is c
+    size_t shift[256];
+
+    // Two-Way: pattern = u v with |u| = critical; period of v
+    size_t critical;
+    size_t period;
+    bool periodic;                  // Whole pattern has that period
+};
+
+// Collects match offsets; addMatch() returns true when the search
+// should stop
+typedef struct {
+    size_t *offsets;
+    size_t max_offsets;
+    size_t count;
+    bool first_only;
+} Matches;
+
+static inline bool addMatch(Matches *matches, size_t offset) {
+    if (matches->offsets != NULL && matches->count < matches->max_offsets) {
+        matches->offsets[matches->count] = offset;
+    }
+    matches->count++;
+    return matches->first_only;
+}
+
+// ===== Two-Way =====
+
+// Start of the maximal suffix of x (as index - 1, so -1 is the whole
+// string) under the byte order, or under the reversed order; *period
+// receives the period of that suffix
+static ptrdiff_t maximalSuffix(const unsigned char *x, size_t m, bool reversed, size_t *period) {
+    ptrdiff_t ms = -1;
+    size_t j = 0, k = 1, p = 1;
+    while (j + k < m) {
+        unsigned char a = x[j + k];
+        unsigned char b = x[ms + (ptrdiff_t)k];
+        if (reversed ? a > b : a < b) {
+            j += k;
+            k = 1;
+            p = (size_t)((ptrdiff_t)j - ms);
+        } else if (a == b) {
+            if (k != p) {
+                k++;
+            } else {
+                j += p;
+                k = 1;
+            }
+        } else {
+            ms = (ptrdiff_t)j;
+            j = (size_t)ms + 1;
+            k = p = 1;
+        }
+    }
+    *period = p;
+    return ms;
+}
+
+// Critical factorization: the later of the two maximal suffixes
+static void prepareTwoWay(StringSearcher *s) {
+    size_t p, q;
+    ptrdiff_t i = maximalSuffix(s->pattern, s->length, false, &p);
+    ptrdiff_t j = maximalSuffix(s->pattern, s->length, true, &q);
+    s->critical = (size_t)((i > j ? i : j) + 1);
+    s->period = i > j ? p : q;
+    s->periodic = memcmp(s->pattern, s->pattern + s->period, s->critical) == 0;
+    if (!s->periodic) {
+        // Two matches can be no closer than this
+        size_t longer = s->critical > s->length - s->critical ? s->critical
+                                                              : s->length - s->critical;
+        s->period = longer + 1;
+    }
+}
+
+// Match the right part v left to right, then the left part u right to
+// left. A mismatch in v shifts past it; a full match shifts by the
+// period, and for periodic patterns remembers how much of the next
+// window is already known to match.
+static bool twoWaySearch(const StringSearcher *s, const unsigned char *y, size_t n, size_t base,
+                         Matches *matches) {
+    const unsigned char *x = s->pattern;
+    size_t m = s->length, crit = s->critical, per = s->period;
+    size_t j = 0, memory = 0;
+    while (j + m <= n) {
+        size_t i = s->periodic && memory > crit ? memory : crit;
+        while (i < m && x[i] == y[i + j]) i++;
+        if (i < m) {
+            j += i - crit + 1;
+            memory = 0;
+            continue;
+        }
+        size_t low = s->periodic ? memory : 0;
+        i = crit;
+        while (i > low && x[i - 1] == y[i - 1 + j]) i--;
+        if (i <= low && addMatch(matches, base + j)) return true;
+        j += per;
+        if (s->periodic) memory = m - per;
+    }
+    return false;
+}
+
+// ===== Horspool =====
+
+static void prepareHorspool(StringSearcher *s) {
+    size_t m = s->length;
+    for (int c = 0; c < 256; c++) s->shift[c] = m;
+    for (size_t i = 0; i + 1 < m; i++) s->shift[s->pattern[i]] = m - 1 - i;
+}
+
+static bool horspoolSearch(const StringSearcher *s, const unsigned char *y, size_t n,
+                           Matches *matches) {
+    const unsigned char *x = s->pattern;
+    size_t m = s->length;
+    unsigned char last = x[m - 1];
+    size_t work = 0;
+    for (size_t j = 0; j + m <= n; j += s->shift[y[j + m - 1]]) {
+        if (y[j + m - 1] != last) continue;
+        // Bounded verification keeps the total linear in n
+        work += m;
+        if (work > HORSPOOL_WORK_FACTOR * (j + m)) {
+            return twoWaySearch(s, y + j, n - j, j, matches);
+        }
+        if (memcmp(y + j, x, m - 1) == 0 && addMatch(matches, j)) return true;
+    }
+    return false;
+}
+
+// ===== First/last-byte filter =====
+
+// A window can match only if its first and last bytes do; testing both
+// for 16 windows at a time rejects almost every position with a few
+// instructions, and memcmp verifies the rest
+static bool filterSearch(const StringSearcher *s, const unsigned char *y, size_t n,
+                         Matches *matches) {
+    const unsigned char *x = s->pattern;
+    size_t m = s->length;
+    size_t i = 0;
+#ifdef __SSE2__
+    const __m128i first = _mm_set1_epi8((char)x[0]);
+    const __m128i last = _mm_set1_epi8((char)x[m - 1]);
+    for (; i + m - 1 + 16 <= n; i += 16) {
+        __m128i eq_first = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(y + i)), first);
+        __m128i eq_last = _mm_cmpeq_epi8(_mm_loadu_si128((const __m128i*)(y + i + m - 1)), last);
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_and_si128(eq_first, eq_last));
+        while (mask != 0) {
+            size_t pos = i + (size_t)__builtin_ctz(mask);
+            if (memcmp(y + pos + 1, x + 1, m - 2) == 0 && addMatch(matches, pos)) return true;
+            mask &= mask - 1;
+        }
+    }
+#endif
+    for (; i + m <= n; i++) {
+        if (y[i] == x[0] && y[i + m - 1] == x[m - 1] && memcmp(y + i + 1, x + 1, m - 2) == 0 &&
+            addMatch(matches, i)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// ===== Searcher =====
+
+StringSearcher* createStringSearcher(const char *pattern, size_t pattern_len) {
+    StringSearcher *s = (StringSearcher*)malloc(sizeof(StringSearcher));
+    s->pattern = (unsigned char*)malloc(pattern_len > 0 ? pattern_len : 1);
+    memcpy(s->pattern, pattern, pattern_len);
+    s->length = pattern_len;
+
+    if (pattern_len == 0) {
+        s->method = METHOD_EMPTY;
+    } else if (pattern_len == 1) {
+        s->method = METHOD_BYTE;
+    } else if (pattern_len <= SEARCH_SHORT_PATTERN) {
+        s->method = METHOD_FILTER;
+    } else {
+        s->method = METHOD_HORSPOOL;
+        prepareHorspool(s);
+        prepareTwoWay(s);
+    }
+    return s;
+}
+
+void freeStringSearcher(StringSearcher *searcher) {
+    if (searcher == NULL) return;
+    free(searcher->pattern);
+    free(searcher);
+}
+
+static void search(const StringSearcher *s, const char *text, size_t text_len, Matches *matches) {
+    const unsigned char *y = (const unsigned char*)text;
+    switch (s->method) {
+        case METHOD_EMPTY:
+            for (size_t i = 0; i <= text_len; i++) {
+                if (addMatch(matches, i)) return;
+            }
+            break;
+        case METHOD_BYTE: {
+            const unsigned char *p = y, *end = y + text_len;
+            while (p < end && (p = (const unsigned char*)memchr(p, s->pattern[0], (size_t)(end - p)))) {
+                if (addMatch(matches, (size_t)(p - y))) return;
+                p++;
+            }
+            break;
+        }
+        case METHOD_FILTER:
+            filterSearch(s, y, text_len, matches);
+            break;
+        case METHOD_HORSPOOL:
+            horspoolSearch(s, y, text_len, matches);
+            break;
+    }
+}
+
+size_t searcherFind(const StringSearcher *searcher, const char *text, size_t text_len) {
+    size_t offset = STRING_NOT_FOUND;
+    Matches matches = { &offset, 1, 0, true };
+    search(searcher, text, text_len, &matches);
+    return offset;
+}
+
+size_t searcherFindAll(const StringSearcher *searcher, const char *text, size_t text_len,
+                       size_t *offsets, size_t max_offsets) {
+    Matches matches = { offsets, max_offsets, 0, false };
+    search(searcher, text, text_len, &matches);
+    return matches.count;
+}
+
+size_t findSubstring(const char *text, size_t text_len, const char *pattern, size_t pattern_len) {
+    StringSearcher *searcher = createStringSearcher(pattern, pattern_len);
+    size_t offset = searcherFind(searcher, text, text_len);
+    freeStringSearcher(searcher);
+    return offset;
+}
+
+size_t findAllSubstrings(const char *text, size_t text_len, const char *pattern,
+                         size_t pattern_len, size_t *offsets, size_t max_offsets) {
+    StringSearcher *searcher = createStringSearcher(pattern, pattern_len);
+    size_t count = searcherFindAll(searcher, text, text_len, offsets, max_offsets);
+    freeStringSearcher(searcher);
+    return count;
+}
@@ -0,0 +1,63 @@
+/*
+ * string_search.h
+ * Substring search over byte buffers with explicit lengths
+ *
+ * The searcher looks at the pattern once and picks a method:
+ *   - 1 byte:        memchr
+ *   - up to 32 bytes: SIMD filter - compare 16 text positions at once
+ *                    against the pattern's first and last byte, and
+ *                    verify only the positions where both match
+ *   - longer:        Horspool, which skips ahead by up to the pattern
+ *                    length after each mismatch. If verification work
+ *                    grows beyond a constant per text byte (periodic
+ *                    text and pattern), the rest of the text is searched
+ *                    with Two-Way, which is linear in the worst case and
+ *                    needs no memory beyond the searcher
+ *
+ * Neither text nor pattern needs a terminating '\0', and both may
+ * contain any byte. Matches may overlap. An empty pattern matches at
+ * every offset from 0 to text_len.
+ */
+
+#ifndef STRING_SEARCH_H
+#define STRING_SEARCH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define STRING_NOT_FOUND SIZE_MAX
+#define SEARCH_SHORT_PATTERN 32     // Longest pattern for the SIMD filter
+
+typedef struct StringSearcher StringSearcher;
+
+/**
+ * @brief Preprocess a pattern for repeated searches
+ * @param pattern Copied; may be freed after the call
+ */
+StringSearcher* createStringSearcher(const char *pattern, size_t pattern_len);
+
+void freeStringSearcher(StringSearcher *searcher);
+
+/**
+ * @brief Offset of the first match in text
+ * @return Offset, or STRING_NOT_FOUND
+ */
+size_t searcherFind(const StringSearcher *searcher, const char *text, size_t text_len);
+
+/**
+ * @brief Every match in text
+ * @param offsets Receives the first max_offsets match offsets in
+ *                increasing order; may be NULL to only count
+ * @return Total number of matches, which may exceed max_offsets
+ */
+size_t searcherFindAll(const StringSearcher *searcher, const char *text, size_t text_len,
+                       size_t *offsets, size_t max_offsets);
+
+/**
+ * @brief One-shot versions of searcherFind and searcherFindAll
+ */
+size_t findSubstring(const char *text, size_t text_len, const char *pattern, size_t pattern_len);
+size_t findAllSubstrings(const char *text, size_t text_len, const char *pattern,
+                         size_t pattern_len, size_t *offsets, size_t max_offsets);
+
+#endif /* STRING_SEARCH_H */
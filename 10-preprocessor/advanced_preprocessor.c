@@ -108,6 +108,42 @@ static const char* color_names[] = {
     #define COMPILER_VERSION "Unknown"
 #endif
 
+// Conditional compilation based on CPU architecture
+#if defined(__x86_64__) || defined(_M_X64)
+    #define ARCH "x86-64"
+#elif defined(__i386__) || defined(_M_IX86)
+    #define ARCH "x86"
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define ARCH "ARM64"
+#else
+    #define ARCH "Unknown"
+#endif
+
+// Widest SIMD extension the compiler may use everywhere (set by -march)
+#if defined(__AVX512F__)
+    #define SIMD_BASELINE "AVX-512"
+#elif defined(__AVX2__)
+    #define SIMD_BASELINE "AVX2"
+#elif defined(__SSE2__) || defined(_M_X64)
+    #define SIMD_BASELINE "SSE2"
+#elif defined(__ARM_NEON)
+    #define SIMD_BASELINE "NEON"
+#else
+    #define SIMD_BASELINE "None"
+#endif
+
+// The running CPU may support more than the baseline. GCC and Clang can
+// ask it at run time, so one binary can carry an AVX-512 version of a
+// function (__attribute__((target("avx512f")))) and call it only when
+// the check passes (see 05-arrays-and-strings/simd_scan.c)
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+    #define HAVE_CPU_SUPPORTS 1
+    #define CPU_SUPPORTS(feature) __builtin_cpu_supports(feature)
+#else
+    #define HAVE_CPU_SUPPORTS 0
+    #define CPU_SUPPORTS(feature) 0
+#endif
+
 // Compile-time assertions
 #define STATIC_ASSERT(expr, msg) \
     typedef char static_assertion_##msg[(expr) ? 1 : -1]
@@ -240,6 +276,20 @@ int main() {
     printf("    Before swap: a=%d, b=%d\n", a, b);
     SWAP(a, b, int);
     printf("    After swap: a=%d, b=%d\n", a, b);
+    printf("\n");
+    
+    // 12. CPU feature detection
+    printf("12. CPU Feature Detection:\n");
+    printf("    Architecture: %s\n", ARCH);
+    printf("    Compile-time SIMD: %s\n", SIMD_BASELINE);
+    #if HAVE_CPU_SUPPORTS
+    printf("    Runtime: SSE2 %s, AVX2 %s, AVX-512 %s\n",
+           CPU_SUPPORTS("sse2") ? "yes" : "no",
+           CPU_SUPPORTS("avx2") ? "yes" : "no",
+           CPU_SUPPORTS("avx512f") ? "yes" : "no");
+    #else
+    printf("    Runtime: not available with this compiler\n");
+    #endif
     
     return 0;
 }
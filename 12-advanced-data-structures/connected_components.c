@@ -0,0 +1,241 @@
+/*
+ * connected_components.c
+ * Union-find and parallel Afforest connected components
+ * Topics: path compression, union by rank, lock-free hooking with CAS,
+ *         sampling the giant component
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include "connected_components.h"
+#include "parallel_for.h"
+
+// ===== Union-find =====
+
+UnionFind* createUnionFind(int num_vertices) {
+    UnionFind *uf = (UnionFind*)malloc(sizeof(UnionFind));
+    uf->parent = (int*)malloc((num_vertices > 0 ? num_vertices : 1) * sizeof(int));
+    uf->rank = (unsigned char*)calloc(num_vertices > 0 ? num_vertices : 1, 1);
+    uf->num_vertices = num_vertices;
+    uf->num_components = num_vertices;
+    for (int i = 0; i < num_vertices; i++) {
+        uf->parent[i] = i;
+    }
+    return uf;
+}
+
+void freeUnionFind(UnionFind *uf) {
+    if (uf == NULL) return;
+    free(uf->parent);
+    free(uf->rank);
+    free(uf);
+}
+
+// Iterative find: locate the root, then point the whole path at it
+int ufFind(UnionFind *uf, int vertex) {
+    int root = vertex;
+    while (uf->parent[root] != root) {
+        root = uf->parent[root];
+    }
+    while (uf->parent[vertex] != root) {
+        int next = uf->parent[vertex];
+        uf->parent[vertex] = root;
+        vertex = next;
+    }
+    return root;
+}
+
+bool ufUnion(UnionFind *uf, int a, int b) {
+    int root_a = ufFind(uf, a);
+    int root_b = ufFind(uf, b);
+    if (root_a == root_b) return false;
+
+    // Attach the shallower tree under the deeper one
+    if (uf->rank[root_a] < uf->rank[root_b]) {
+        uf->parent[root_a] = root_b;
+    } else if (uf->rank[root_a] > uf->rank[root_b]) {
+        uf->parent[root_b] = root_a;
+    } else {
+        uf->parent[root_b] = root_a;
+        uf->rank[root_a]++;
+    }
+    uf->num_components--;
+    return true;
+}
+
+void ufAddEdges(UnionFind *uf, const Edge *edges, long long num_edges) {
+    for (long long e = 0; e < num_edges; e++) {
+        ufUnion(uf, edges[e].src, edges[e].dest);
+    }
+}
+
+int* componentsUnionFind(const CSRGraph *graph, int *num_components) {
+    int n = graph->num_vertices;
+    UnionFind *uf = createUnionFind(n);
+
+    for (int u = 0; u < n; u++) {
+        for (long long i = graph->offsets[u]; i < graph->offsets[u + 1]; i++) {
+            int v = graph->targets[i];
+            if (u < v || graph->directed) ufUnion(uf, u, v);   // Each undirected edge once
+        }
+    }
+
+    int *comp = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    for (int v = 0; v < n; v++) {
+        comp[v] = ufFind(uf, v);
+    }
+    if (num_components != NULL) *num_components = uf->num_components;
+    freeUnionFind(uf);
+    return comp;
+}
+
+// ===== Parallel Afforest =====
+
+#define AFFOREST_ROUNDS 2      // Neighbors linked per vertex before sampling
+#define AFFOREST_SAMPLES 1024  // Vertices sampled to find the giant component
+#define AFFOREST_CHUNK 1024
+
+typedef struct AfforestJob AfforestJob;
+
+struct AfforestJob {
+    const CSRGraph *graph;
+    _Atomic int *comp;
+    int round;              // Neighbor index linked in this round
+    int skip_component;     // Vertices in this component are skipped
+    void (*body)(AfforestJob *job, int begin, int end);
+};
+
+// Hook the larger root under the smaller one; retries until u and v
+// share a root. Roots only ever point to smaller ids.
+static void hookRoots(_Atomic int *comp, int u, int v) {
+    int p1 = atomic_load_explicit(&comp[u], memory_order_relaxed);
+    int p2 = atomic_load_explicit(&comp[v], memory_order_relaxed);
+    while (p1 != p2) {
+        int high = p1 > p2 ? p1 : p2;
+        int low = p1 < p2 ? p1 : p2;
+        int p_high = atomic_load_explicit(&comp[high], memory_order_relaxed);
+        if (p_high == low) break;
+        if (p_high == high) {
+            int expected = high;
+            if (atomic_compare_exchange_strong_explicit(&comp[high], &expected, low,
+                                                        memory_order_relaxed,
+                                                        memory_order_relaxed)) {
+                break;
+            }
+        }
+        p1 = atomic_load_explicit(&comp[atomic_load_explicit(&comp[high], memory_order_relaxed)],
+                                  memory_order_relaxed);
+        p2 = atomic_load_explicit(&comp[low], memory_order_relaxed);
+    }
+}
+
+static void compressRange(AfforestJob *job, int begin, int end) {
+    _Atomic int *comp = job->comp;
+    for (int v = begin; v < end; v++) {
+        int c = atomic_load_explicit(&comp[v], memory_order_relaxed);
+        int cc = atomic_load_explicit(&comp[c], memory_order_relaxed);
+        while (c != cc) {
+            c = cc;
+            cc = atomic_load_explicit(&comp[c], memory_order_relaxed);
+        }
+        atomic_store_explicit(&comp[v], c, memory_order_relaxed);
+    }
+}
+
+static void linkRoundRange(AfforestJob *job, int begin, int end) {
+    const CSRGraph *graph = job->graph;
+    for (int u = begin; u < end; u++) {
+        long long i = graph->offsets[u] + job->round;
+        if (i < graph->offsets[u + 1]) {
+            hookRoots(job->comp, u, graph->targets[i]);
+        }
+    }
+}
+
+static void linkRemainingRange(AfforestJob *job, int begin, int end) {
+    const CSRGraph *graph = job->graph;
+    for (int u = begin; u < end; u++) {
+        if (atomic_load_explicit(&job->comp[u], memory_order_relaxed) == job->skip_component) {
+            continue;
+        }
+        for (long long i = graph->offsets[u] + AFFOREST_ROUNDS; i < graph->offsets[u + 1]; i++) {
+            hookRoots(job->comp, u, graph->targets[i]);
+        }
+    }
+}
+
+static void runAfforestBody(void *context, long long begin, long long end, int thread) {
+    (void)thread;
+    AfforestJob *job = (AfforestJob*)context;
+    job->body(job, (int)begin, (int)end);
+}
+
+// Run body over all vertices on num_threads threads
+static void parallelForVertices(AfforestJob *job, int num_threads,
+                                void (*body)(AfforestJob*, int, int)) {
+    job->body = body;
+    parallelFor(job->graph->num_vertices, AFFOREST_CHUNK, num_threads, runAfforestBody, job);
+}
+
+// Most frequent component id among a random sample of vertices
+static int sampleFrequentComponent(_Atomic int *comp, int n) {
+    int *samples = (int*)malloc(AFFOREST_SAMPLES * sizeof(int));
+    uint64_t seed = 0x2545F4914F6CDD1DULL;
+    for (int i = 0; i < AFFOREST_SAMPLES; i++) {
+        seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+        samples[i] = atomic_load_explicit(&comp[seed % (uint64_t)n], memory_order_relaxed);
+    }
+
+    // Sample is small: count by brute force against distinct values
+    int best = samples[0], best_count = 0;
+    for (int i = 0; i < AFFOREST_SAMPLES; i++) {
+        int count = 0;
+        for (int j = 0; j < AFFOREST_SAMPLES; j++) {
+            count += samples[j] == samples[i];
+        }
+        if (count > best_count) {
+            best_count = count;
+            best = samples[i];
+        }
+        if (best_count > AFFOREST_SAMPLES / 2) break;
+    }
+    free(samples);
+    return best;
+}
+
+int* componentsAfforest(const CSRGraph *graph, int num_threads, int *num_components) {
+    int n = graph->num_vertices;
+    if (num_threads < 1) num_threads = 1;
+
+    AfforestJob job;
+    job.graph = graph;
+    job.comp = (_Atomic int*)malloc((n > 0 ? n : 1) * sizeof(_Atomic int));
+    for (int v = 0; v < n; v++) atomic_init(&job.comp[v], v);
+    job.skip_component = -1;
+
+    // Link a few neighbors of every vertex: usually enough to form the
+    // giant component without looking at most edges
+    for (job.round = 0; job.round < AFFOREST_ROUNDS; job.round++) {
+        parallelForVertices(&job, num_threads, linkRoundRange);
+        parallelForVertices(&job, num_threads, compressRange);
+    }
+
+    if (n > 0) {
+        job.skip_component = sampleFrequentComponent(job.comp, n);
+        parallelForVertices(&job, num_threads, linkRemainingRange);
+        parallelForVertices(&job, num_threads, compressRange);
+    }
+
+    int *comp = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    int count = 0;
+    for (int v = 0; v < n; v++) {
+        comp[v] = atomic_load_explicit(&job.comp[v], memory_order_relaxed);
+        if (comp[v] == v) count++;
+    }
+    if (num_components != NULL) *num_components = count;
+    free((void*)job.comp);
+    return comp;
+}
@@ -0,0 +1,59 @@
+/*
+ * connected_components.h
+ * Connected components without recursion
+ *
+ * UnionFind      - disjoint sets with path compression and union by
+ *                  rank; edges can be fed in any order, in batches, so
+ *                  it also works on an edge list streamed from disk
+ * afforest       - parallel components on a CSR graph: link a few
+ *                  neighbors of every vertex, find the giant component,
+ *                  then only process edges of vertices outside it
+ */
+
+#ifndef CONNECTED_COMPONENTS_H
+#define CONNECTED_COMPONENTS_H
+
+#include <stdbool.h>
+#include "csr_graph.h"
+
+typedef struct {
+    int *parent;
+    unsigned char *rank;
+    int num_vertices;
+    int num_components;     // Kept up to date by ufUnion
+} UnionFind;
+
+UnionFind* createUnionFind(int num_vertices);
+void freeUnionFind(UnionFind *uf);
+
+/**
+ * @brief Representative of the set containing vertex (compresses the path)
+ */
+int ufFind(UnionFind *uf, int vertex);
+
+/**
+ * @brief Merge the sets of a and b
+ * @return true if they were in different sets
+ */
+bool ufUnion(UnionFind *uf, int a, int b);
+
+/**
+ * @brief Feed one batch of a (possibly streamed) edge list
+ */
+void ufAddEdges(UnionFind *uf, const Edge *edges, long long num_edges);
+
+/**
+ * @brief Component id of every vertex using union-find over a CSR graph
+ * @param num_components Optional, receives the number of components
+ * @return Array of num_vertices ids (the set representative); caller frees
+ */
+int* componentsUnionFind(const CSRGraph *graph, int *num_components);
+
+/**
+ * @brief Parallel Afforest components of an undirected CSR graph
+ * @param num_components Optional, receives the number of components
+ * @return Array of num_vertices ids (smallest-id root); caller frees
+ */
+int* componentsAfforest(const CSRGraph *graph, int num_threads, int *num_components);
+
+#endif /* CONNECTED_COMPONENTS_H */
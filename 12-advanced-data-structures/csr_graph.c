@@ -0,0 +1,324 @@
+/*
+ * csr_graph.c
+ * Compressed sparse row (CSR) graph: construction and traversals
+ * Topics: two-pass build, flat adjacency arrays, iterative DFS engine
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "csr_graph.h"
+#include "directed_graph.h"
+
+// Build CSR from an edge list: pass 1 counts degrees, pass 2 scatters
+CSRGraph* csrBuild(int num_vertices, const Edge *edges, long long num_edges, int flags) {
+    if (num_vertices < 0 || num_edges < 0) return NULL;
+
+    bool directed = (flags & CSR_DIRECTED) != 0;
+    bool weighted = (flags & CSR_WEIGHTED) != 0;
+
+    for (long long e = 0; e < num_edges; e++) {
+        if (edges[e].src < 0 || edges[e].src >= num_vertices ||
+            edges[e].dest < 0 || edges[e].dest >= num_vertices) {
+            return NULL;
+        }
+    }
+
+    CSRGraph *graph = (CSRGraph*)malloc(sizeof(CSRGraph));
+    if (graph == NULL) return NULL;
+    graph->num_vertices = num_vertices;
+    graph->num_arcs = directed ? num_edges : 2 * num_edges;
+    graph->directed = directed;
+    graph->mapped_base = NULL;
+    graph->mapped_size = 0;
+    graph->offsets = (long long*)calloc((size_t)num_vertices + 1, sizeof(long long));
+    graph->targets = (int*)malloc((size_t)(graph->num_arcs ? graph->num_arcs : 1) * sizeof(int));
+    graph->weights = weighted
+        ? (int*)malloc((size_t)(graph->num_arcs ? graph->num_arcs : 1) * sizeof(int))
+        : NULL;
+    if (graph->offsets == NULL || graph->targets == NULL || (weighted && graph->weights == NULL)) {
+        csrFree(graph);
+        return NULL;
+    }
+
+    // Pass 1: degree of each vertex, stored one slot ahead
+    long long *offsets = graph->offsets;
+    for (long long e = 0; e < num_edges; e++) {
+        offsets[edges[e].src + 1]++;
+        if (!directed) offsets[edges[e].dest + 1]++;
+    }
+
+    // Prefix sum turns degrees into start offsets
+    for (int v = 0; v < num_vertices; v++) {
+        offsets[v + 1] += offsets[v];
+    }
+
+    // Pass 2: scatter targets, using a cursor per vertex
+    long long *cursor = (long long*)malloc(((size_t)num_vertices + 1) * sizeof(long long));
+    if (cursor == NULL) {
+        csrFree(graph);
+        return NULL;
+    }
+    memcpy(cursor, offsets, (size_t)num_vertices * sizeof(long long));
+
+    for (long long e = 0; e < num_edges; e++) {
+        int src = edges[e].src;
+        int dest = edges[e].dest;
+        long long slot = cursor[src]++;
+        graph->targets[slot] = dest;
+        if (weighted) graph->weights[slot] = edges[e].weight;
+        if (!directed) {
+            slot = cursor[dest]++;
+            graph->targets[slot] = src;
+            if (weighted) graph->weights[slot] = edges[e].weight;
+        }
+    }
+
+    free(cursor);
+    return graph;
+}
+
+void csrFree(CSRGraph *graph) {
+    if (graph == NULL) return;
+    if (graph->mapped_base != NULL) {
+        // Arrays point into the snapshot mapping
+        munmap(graph->mapped_base, (size_t)graph->mapped_size);
+        free(graph);
+        return;
+    }
+    free(graph->offsets);
+    free(graph->targets);
+    free(graph->weights);
+    free(graph);
+}
+
+typedef struct {
+    int target;
+    int weight;
+} WeightedArc;
+
+static int compareInts(const void *a, const void *b) {
+    int x = *(const int*)a, y = *(const int*)b;
+    return (x > y) - (x < y);
+}
+
+static int compareArcs(const void *a, const void *b) {
+    return compareInts(&((const WeightedArc*)a)->target, &((const WeightedArc*)b)->target);
+}
+
+// Sort each neighbor list; short lists by insertion sort, weights move
+// along with their targets
+void csrSortNeighbors(CSRGraph *graph) {
+    long long max_degree = 0;
+    for (int v = 0; v < graph->num_vertices; v++) {
+        if (csrDegree(graph, v) > max_degree) max_degree = csrDegree(graph, v);
+    }
+    WeightedArc *scratch = graph->weights != NULL
+        ? (WeightedArc*)malloc((max_degree > 0 ? max_degree : 1) * sizeof(WeightedArc))
+        : NULL;
+
+    for (int v = 0; v < graph->num_vertices; v++) {
+        int *targets = graph->targets + graph->offsets[v];
+        int *weights = graph->weights != NULL ? graph->weights + graph->offsets[v] : NULL;
+        long long degree = csrDegree(graph, v);
+
+        if (degree <= 16) {
+            for (long long i = 1; i < degree; i++) {
+                int target = targets[i];
+                int weight = weights != NULL ? weights[i] : 0;
+                long long j = i;
+                while (j > 0 && targets[j - 1] > target) {
+                    targets[j] = targets[j - 1];
+                    if (weights != NULL) weights[j] = weights[j - 1];
+                    j--;
+                }
+                targets[j] = target;
+                if (weights != NULL) weights[j] = weight;
+            }
+        } else if (weights == NULL) {
+            qsort(targets, degree, sizeof(int), compareInts);
+        } else {
+            for (long long i = 0; i < degree; i++) scratch[i] = (WeightedArc){ targets[i], weights[i] };
+            qsort(scratch, degree, sizeof(WeightedArc), compareArcs);
+            for (long long i = 0; i < degree; i++) {
+                targets[i] = scratch[i].target;
+                weights[i] = scratch[i].weight;
+            }
+        }
+    }
+    free(scratch);
+}
+
+// BFS: every vertex enters the queue at most once, so an n-slot array suffices
+int csrBFS(const CSRGraph *graph, int start, int *order) {
+    int n = graph->num_vertices;
+    bool *visited = (bool*)calloc(n, sizeof(bool));
+    int *queue = (int*)malloc(n * sizeof(int));
+    int head = 0, tail = 0;
+
+    visited[start] = true;
+    queue[tail++] = start;
+
+    while (head < tail) {
+        int vertex = queue[head++];
+        for (long long i = graph->offsets[vertex]; i < graph->offsets[vertex + 1]; i++) {
+            int adj_vertex = graph->targets[i];
+            if (!visited[adj_vertex]) {
+                visited[adj_vertex] = true;
+                queue[tail++] = adj_vertex;
+            }
+        }
+    }
+
+    if (order != NULL) memcpy(order, queue, tail * sizeof(int));
+    free(visited);
+    free(queue);
+    return tail;
+}
+
+// One suspended call of the recursive DFS: where to resume scanning
+typedef struct {
+    int vertex;
+    int parent;
+    long long next_edge;
+} DFSFrame;
+
+bool csrDFSVisit(const CSRGraph *graph, int start, bool *visited, const DFSVisitor *visitor) {
+    static const DFSVisitor no_callbacks = { NULL, NULL, NULL, NULL };
+    if (visitor == NULL) visitor = &no_callbacks;
+    void *context = visitor->context;
+
+    int capacity = 64;
+    int top = 0;
+    DFSFrame *stack = (DFSFrame*)malloc(capacity * sizeof(DFSFrame));
+    bool keep_going = true;
+
+    visited[start] = true;
+    stack[top++] = (DFSFrame){ start, -1, graph->offsets[start] };
+    if (visitor->pre_order) keep_going = visitor->pre_order(start, -1, context);
+
+    while (keep_going && top > 0) {
+        DFSFrame *frame = &stack[top - 1];
+        int vertex = frame->vertex;
+
+        if (frame->next_edge == graph->offsets[vertex + 1]) {
+            int parent = frame->parent;
+            top--;
+            if (visitor->post_order) keep_going = visitor->post_order(vertex, parent, context);
+            continue;
+        }
+
+        int adj_vertex = graph->targets[frame->next_edge++];
+        if (visited[adj_vertex]) {
+            if (visitor->visited_edge) {
+                keep_going = visitor->visited_edge(vertex, adj_vertex, frame->parent, context);
+            }
+            continue;
+        }
+
+        // "Recurse": push a frame for the neighbor
+        visited[adj_vertex] = true;
+        if (top == capacity) {
+            capacity *= 2;
+            stack = (DFSFrame*)realloc(stack, capacity * sizeof(DFSFrame));
+        }
+        stack[top++] = (DFSFrame){ adj_vertex, vertex, graph->offsets[adj_vertex] };
+        if (visitor->pre_order) keep_going = visitor->pre_order(adj_vertex, vertex, context);
+    }
+
+    free(stack);
+    return keep_going;
+}
+
+typedef struct {
+    int *order;
+    int count;
+} VisitOrder;
+
+static bool recordVisit(int vertex, int parent, void *context) {
+    (void)parent;
+    VisitOrder *visit = (VisitOrder*)context;
+    if (visit->order != NULL) visit->order[visit->count] = vertex;
+    visit->count++;
+    return true;
+}
+
+int csrDFS(const CSRGraph *graph, int start, int *order) {
+    bool *visited = (bool*)calloc(graph->num_vertices, sizeof(bool));
+    VisitOrder visit = { order, 0 };
+    DFSVisitor visitor = { recordVisit, NULL, NULL, &visit };
+
+    csrDFSVisit(graph, start, visited, &visitor);
+
+    free(visited);
+    return visit.count;
+}
+
+// Unweighted shortest path: BFS recording parents, stopping at end
+int csrShortestPath(const CSRGraph *graph, int start, int end, int *path) {
+    int n = graph->num_vertices;
+    int *parent = (int*)malloc(n * sizeof(int));
+    int *queue = (int*)malloc(n * sizeof(int));
+    int head = 0, tail = 0;
+
+    for (int i = 0; i < n; i++) parent[i] = -1;
+    parent[start] = start;
+    queue[tail++] = start;
+
+    while (head < tail && parent[end] == -1) {
+        int vertex = queue[head++];
+        for (long long i = graph->offsets[vertex]; i < graph->offsets[vertex + 1]; i++) {
+            int adj_vertex = graph->targets[i];
+            if (parent[adj_vertex] == -1) {
+                parent[adj_vertex] = vertex;
+                queue[tail++] = adj_vertex;
+            }
+        }
+    }
+
+    int path_len = 0;
+    if (parent[end] != -1) {
+        // Walk back from end, then reverse in place
+        for (int current = end; ; current = parent[current]) {
+            if (path != NULL) path[path_len] = current;
+            path_len++;
+            if (current == start) break;
+        }
+        for (int i = 0; path != NULL && i < path_len / 2; i++) {
+            int tmp = path[i];
+            path[i] = path[path_len - 1 - i];
+            path[path_len - 1 - i] = tmp;
+        }
+    }
+
+    free(parent);
+    free(queue);
+    return path_len;
+}
+
+int csrCountComponents(const CSRGraph *graph) {
+    int n = graph->num_vertices;
+    bool *visited = (bool*)calloc(n, sizeof(bool));
+    int count = 0;
+
+    for (int v = 0; v < n; v++) {
+        if (!visited[v]) {
+            csrDFSVisit(graph, v, visited, NULL);
+            count++;
+        }
+    }
+
+    free(visited);
+    return count;
+}
+
+// A forest with c components has exactly n - c edges; any extra edge
+// (including a self loop or a repeated edge) closes a cycle. A directed
+// graph has one exactly when it has no topological order.
+bool csrHasCycle(const CSRGraph *graph) {
+    if (graph->directed) return !topologicalSort(graph, 1, NULL, NULL);
+    long long edges = graph->num_arcs / 2;
+    return edges > (long long)graph->num_vertices - csrCountComponents(graph);
+}
@@ -0,0 +1,129 @@
+/*
+ * csr_graph.h
+ * Compressed sparse row (CSR) graph representation
+ *
+ * All neighbors of vertex v live contiguously in
+ *     targets[offsets[v]] .. targets[offsets[v + 1] - 1]
+ * so a traversal walks two flat arrays instead of chasing one malloc'd
+ * Node per edge. The graph is built from an edge list in two passes:
+ * count degrees, prefix-sum them into offsets, then scatter targets.
+ */
+
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include <stdbool.h>
+
+// Build flags
+#define CSR_DIRECTED 1   // Keep edges one-way (default: add both directions)
+#define CSR_WEIGHTED 2   // Store edge weights (default: weights == NULL)
+
+typedef struct {
+    int src;
+    int dest;
+    int weight;
+} Edge;
+
+typedef struct {
+    int num_vertices;
+    long long num_arcs;     // Stored directed arcs (2x edges if undirected)
+    bool directed;
+    long long *offsets;     // num_vertices + 1 entries
+    int *targets;           // num_arcs entries
+    int *weights;           // num_arcs entries, or NULL
+    void *mapped_base;      // Non-NULL when the arrays live in an mmap'd snapshot
+    long long mapped_size;
+} CSRGraph;
+
+/**
+ * @brief Build a CSR graph from an edge list in two passes
+ * @param num_vertices Vertex ids must be in [0, num_vertices)
+ * @param edges Edge list (not modified)
+ * @param num_edges Number of edges
+ * @param flags CSR_DIRECTED and/or CSR_WEIGHTED
+ * @return New graph, or NULL on invalid input / allocation failure
+ */
+CSRGraph* csrBuild(int num_vertices, const Edge *edges, long long num_edges, int flags);
+
+/**
+ * @brief Release a graph built by csrBuild or mapped by csrMapSnapshot
+ */
+void csrFree(CSRGraph *graph);
+
+/**
+ * @brief Sort every neighbor list by target id (weights follow)
+ *
+ * Sorted lists let neighbor sets be intersected by merging, as the
+ * triangle counter does.
+ */
+void csrSortNeighbors(CSRGraph *graph);
+
+/**
+ * @brief Number of neighbors of a vertex
+ */
+static inline long long csrDegree(const CSRGraph *graph, int vertex) {
+    return graph->offsets[vertex + 1] - graph->offsets[vertex];
+}
+
+/**
+ * @brief Callbacks for the iterative DFS engine
+ *
+ * pre_order fires when a vertex is first reached (parent is -1 for the
+ * start), post_order when all its neighbors are done, visited_edge for
+ * an edge to a vertex that was already reached. Any callback may be
+ * NULL; returning false from one stops the search.
+ */
+typedef struct {
+    bool (*pre_order)(int vertex, int parent, void *context);
+    bool (*post_order)(int vertex, int parent, void *context);
+    bool (*visited_edge)(int vertex, int neighbor, int parent, void *context);
+    void *context;
+} DFSVisitor;
+
+/**
+ * @brief Iterative DFS from start over vertices not yet marked visited
+ * @param visited num_vertices flags, updated as vertices are reached
+ * @param visitor Callbacks, or NULL to only mark vertices
+ * @return false if a callback stopped the search
+ *
+ * The work stack lives on the heap and grows with the search depth, so
+ * a path of millions of vertices uses constant native stack space.
+ */
+bool csrDFSVisit(const CSRGraph *graph, int start, bool *visited, const DFSVisitor *visitor);
+
+/**
+ * @brief Breadth first search
+ * @param order If not NULL, receives vertices in visit order
+ * @return Number of vertices reached from start
+ */
+int csrBFS(const CSRGraph *graph, int start, int *order);
+
+/**
+ * @brief Depth first search (pre-order, explicit stack, no recursion)
+ * @param order If not NULL, receives vertices in visit order
+ * @return Number of vertices reached from start
+ */
+int csrDFS(const CSRGraph *graph, int start, int *order);
+
+/**
+ * @brief Unweighted shortest path using BFS
+ * @param path If not NULL, receives start..end (room for num_vertices)
+ * @return Number of vertices on the path, or 0 if end is unreachable
+ */
+int csrShortestPath(const CSRGraph *graph, int start, int end, int *path);
+
+/**
+ * @brief Count connected components (undirected graphs)
+ */
+int csrCountComponents(const CSRGraph *graph);
+
+/**
+ * @brief Check a graph for a cycle
+ *
+ * Undirected graphs compare the edge count with a spanning forest;
+ * directed graphs (CSR_DIRECTED) look for a directed cycle with
+ * topologicalSort() from directed_graph.h.
+ */
+bool csrHasCycle(const CSRGraph *graph);
+
+#endif /* CSR_GRAPH_H */
@@ -0,0 +1,239 @@
+/*
+ * directed_graph.c
+ * Iterative Tarjan SCC and parallel level-synchronous Kahn ordering
+ * Topics: lowlinks on an explicit DFS stack, atomic in-degree counters,
+ *         per-thread output buffers, barrier-driven levels
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "directed_graph.h"
+
+// ===== Tarjan =====
+// The DFS engine reports pre-order, post-order and edges to vertices
+// already reached; that is all Tarjan's algorithm needs.
+
+typedef struct {
+    int *index;             // DFS discovery number
+    int *lowlink;           // Smallest index reachable through the subtree
+    bool *on_stack;
+    int *stack;             // Vertices of components not yet emitted
+    int top;
+    int next_index;
+    int *comp;
+    int num_components;
+} TarjanState;
+
+static bool tarjanDiscover(int vertex, int parent, void *context) {
+    (void)parent;
+    TarjanState *t = (TarjanState*)context;
+    t->index[vertex] = t->lowlink[vertex] = t->next_index++;
+    t->stack[t->top++] = vertex;
+    t->on_stack[vertex] = true;
+    return true;
+}
+
+static bool tarjanSeen(int vertex, int neighbor, int parent, void *context) {
+    (void)parent;
+    TarjanState *t = (TarjanState*)context;
+    if (t->on_stack[neighbor] && t->index[neighbor] < t->lowlink[vertex]) {
+        t->lowlink[vertex] = t->index[neighbor];
+    }
+    return true;
+}
+
+static bool tarjanFinish(int vertex, int parent, void *context) {
+    TarjanState *t = (TarjanState*)context;
+    if (t->lowlink[vertex] == t->index[vertex]) {
+        // vertex is the root of a component: pop it off the stack
+        int member;
+        do {
+            member = t->stack[--t->top];
+            t->on_stack[member] = false;
+            t->comp[member] = t->num_components;
+        } while (member != vertex);
+        t->num_components++;
+    }
+    if (parent != -1 && t->lowlink[vertex] < t->lowlink[parent]) {
+        t->lowlink[parent] = t->lowlink[vertex];
+    }
+    return true;
+}
+
+int* tarjanSCC(const CSRGraph *graph, int *num_components) {
+    int n = graph->num_vertices;
+    size_t slots = n > 0 ? (size_t)n : 1;
+    TarjanState t;
+    t.index = (int*)malloc(slots * sizeof(int));
+    t.lowlink = (int*)malloc(slots * sizeof(int));
+    t.on_stack = (bool*)calloc(slots, sizeof(bool));
+    t.stack = (int*)malloc(slots * sizeof(int));
+    t.top = 0;
+    t.next_index = 0;
+    t.comp = (int*)malloc(slots * sizeof(int));
+    t.num_components = 0;
+
+    bool *visited = (bool*)calloc(slots, sizeof(bool));
+    DFSVisitor visitor = { tarjanDiscover, tarjanFinish, tarjanSeen, &t };
+    for (int v = 0; v < n; v++) {
+        if (!visited[v]) csrDFSVisit(graph, v, visited, &visitor);
+    }
+
+    if (num_components != NULL) *num_components = t.num_components;
+    free(visited);
+    free(t.index);
+    free(t.lowlink);
+    free(t.on_stack);
+    free(t.stack);
+    return t.comp;
+}
+
+// ===== Parallel Kahn =====
+// order doubles as the queue: level L occupies order[level_begin,
+// level_end) and workers append level L + 1 after it.
+
+#define KAHN_CHUNK 256
+#define KAHN_BUFFER 1024
+
+typedef struct {
+    const CSRGraph *graph;
+    int num_threads;
+    _Atomic int *in_degree;
+    int *order;
+    long long level_begin;
+    long long level_end;
+    atomic_llong next_index;
+    atomic_llong tail;              // Next free slot in order
+    int levels;
+    pthread_barrier_t barrier;
+} KahnShared;
+
+typedef struct {
+    KahnShared *shared;
+    int buffer[KAHN_BUFFER];        // Ready vertices not yet in order
+    int count;
+} KahnWorker;
+
+static void flushReady(KahnWorker *w) {
+    long long slot = atomic_fetch_add(&w->shared->tail, w->count);
+    memcpy(w->shared->order + slot, w->buffer, w->count * sizeof(int));
+    w->count = 0;
+}
+
+static inline void pushReady(KahnWorker *w, int vertex) {
+    if (w->count == KAHN_BUFFER) flushReady(w);
+    w->buffer[w->count++] = vertex;
+}
+
+// Claim chunks of [0, count) until none are left
+static bool claimChunk(KahnShared *s, long long count, long long *begin, long long *end) {
+    *begin = atomic_fetch_add(&s->next_index, KAHN_CHUNK);
+    if (*begin >= count) return false;
+    *end = *begin + KAHN_CHUNK < count ? *begin + KAHN_CHUNK : count;
+    return true;
+}
+
+static void* kahnWorker(void *arg) {
+    KahnWorker *w = (KahnWorker*)arg;
+    KahnShared *s = w->shared;
+    const CSRGraph *graph = s->graph;
+    int n = graph->num_vertices;
+    long long begin, end;
+
+    // In-degrees
+    while (claimChunk(s, n, &begin, &end)) {
+        for (long long u = begin; u < end; u++) {
+            for (long long i = graph->offsets[u]; i < graph->offsets[u + 1]; i++) {
+                atomic_fetch_add_explicit(&s->in_degree[graph->targets[i]], 1,
+                                          memory_order_relaxed);
+            }
+        }
+    }
+    if (pthread_barrier_wait(&s->barrier) == PTHREAD_BARRIER_SERIAL_THREAD) {
+        atomic_store(&s->next_index, 0);
+    }
+    pthread_barrier_wait(&s->barrier);
+
+    // Level 0: vertices without dependencies
+    while (claimChunk(s, n, &begin, &end)) {
+        for (long long v = begin; v < end; v++) {
+            if (atomic_load_explicit(&s->in_degree[v], memory_order_relaxed) == 0) {
+                pushReady(w, (int)v);
+            }
+        }
+    }
+    flushReady(w);
+
+    while (true) {
+        if (pthread_barrier_wait(&s->barrier) == PTHREAD_BARRIER_SERIAL_THREAD) {
+            s->level_begin = s->level_end;
+            s->level_end = atomic_load(&s->tail);
+            atomic_store(&s->next_index, 0);
+            if (s->level_end > s->level_begin) s->levels++;
+        }
+        pthread_barrier_wait(&s->barrier);
+        if (s->level_end == s->level_begin) break;
+
+        // The thread that drops a vertex's in-degree to zero owns it
+        long long level_size = s->level_end - s->level_begin;
+        while (claimChunk(s, level_size, &begin, &end)) {
+            for (long long f = s->level_begin + begin; f < s->level_begin + end; f++) {
+                int u = s->order[f];
+                for (long long i = graph->offsets[u]; i < graph->offsets[u + 1]; i++) {
+                    int v = graph->targets[i];
+                    if (atomic_fetch_sub_explicit(&s->in_degree[v], 1, memory_order_acq_rel) == 1) {
+                        pushReady(w, v);
+                    }
+                }
+            }
+        }
+        flushReady(w);
+    }
+    return NULL;
+}
+
+bool topologicalSort(const CSRGraph *graph, int num_threads, int *order, int *num_levels) {
+    int n = graph->num_vertices;
+    size_t slots = n > 0 ? (size_t)n : 1;
+    if (num_threads < 1) num_threads = 1;
+
+    KahnShared shared;
+    shared.graph = graph;
+    shared.num_threads = num_threads;
+    shared.in_degree = (_Atomic int*)malloc(slots * sizeof(_Atomic int));
+    for (int v = 0; v < n; v++) atomic_init(&shared.in_degree[v], 0);
+    shared.order = order != NULL ? order : (int*)malloc(slots * sizeof(int));
+    shared.level_begin = 0;
+    shared.level_end = 0;
+    atomic_init(&shared.next_index, 0);
+    atomic_init(&shared.tail, 0);
+    shared.levels = 0;
+    pthread_barrier_init(&shared.barrier, NULL, num_threads);
+
+    pthread_t *threads = (pthread_t*)malloc(num_threads * sizeof(pthread_t));
+    KahnWorker *workers = (KahnWorker*)malloc(num_threads * sizeof(KahnWorker));
+    for (int t = 0; t < num_threads; t++) {
+        workers[t].shared = &shared;
+        workers[t].count = 0;
+        if (t > 0) pthread_create(&threads[t], NULL, kahnWorker, &workers[t]);
+    }
+    kahnWorker(&workers[0]);
+    for (int t = 1; t < num_threads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    // Vertices on or behind a cycle never reach in-degree zero
+    bool acyclic = atomic_load(&shared.tail) == n;
+    if (num_levels != NULL) *num_levels = shared.levels;
+
+    if (order == NULL) free(shared.order);
+    free((void*)shared.in_degree);
+    free(workers);
+    free(threads);
+    pthread_barrier_destroy(&shared.barrier);
+    return acyclic;
+}
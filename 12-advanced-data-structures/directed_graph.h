@@ -0,0 +1,39 @@
+/*
+ * directed_graph.h
+ * Strongly connected components and topological order of directed
+ * CSR graphs (built with CSR_DIRECTED)
+ *
+ * tarjanSCC()       - Tarjan's algorithm on the iterative DFS engine,
+ *                     so million-vertex dependency chains do not
+ *                     overflow the native stack
+ * topologicalSort() - level-synchronous Kahn's algorithm: all vertices
+ *                     whose in-degree drops to zero form the next level,
+ *                     and threads decrement atomic in-degree counters
+ */
+
+#ifndef DIRECTED_GRAPH_H
+#define DIRECTED_GRAPH_H
+
+#include <stdbool.h>
+#include "csr_graph.h"
+
+/**
+ * @brief Strongly connected components
+ * @param num_components Optional, receives the number of components
+ * @return Component id of every vertex (caller frees). Ids are in
+ *         reverse topological order of the condensation: every arc
+ *         between components goes from a higher id to a lower one.
+ */
+int* tarjanSCC(const CSRGraph *graph, int *num_components);
+
+/**
+ * @brief Parallel topological sort
+ * @param order If not NULL, receives all vertices, level by level
+ * @param num_levels If not NULL, receives the number of levels (the
+ *                   longest dependency chain, in vertices)
+ * @return false if the graph has a cycle (order then holds only the
+ *         vertices that do not depend on one)
+ */
+bool topologicalSort(const CSRGraph *graph, int num_threads, int *order, int *num_levels);
+
+#endif /* DIRECTED_GRAPH_H */
@@ -0,0 +1,248 @@
+/*
+ * dynamic_graph.c
+ * Batched edge updates over pooled per-vertex adjacency blocks
+ * Topics: size-class block pools, free lists, incremental union-find,
+ *         bounded searches with epoch-stamped scratch arrays
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "dynamic_graph.h"
+
+// ===== Block pool =====
+
+struct Slab {
+    Slab *next;
+    size_t used;            // Neighbors handed out from data
+    size_t size;
+    Neighbor data[];
+};
+
+static inline size_t blockItems(int size_class) {
+    return (size_t)DG_MIN_BLOCK << size_class;
+}
+
+static Neighbor* poolAlloc(BlockPool *pool, int size_class) {
+    Neighbor *block = pool->free_lists[size_class];
+    if (block != NULL) {
+        // A free block stores the next free block in its first bytes
+        memcpy(&pool->free_lists[size_class], block, sizeof(Neighbor*));
+        return block;
+    }
+
+    size_t items = blockItems(size_class);
+    Slab *slab = pool->slabs;
+    if (slab == NULL || slab->size - slab->used < items) {
+        size_t size = DG_SLAB_BYTES / sizeof(Neighbor);
+        if (size < items) size = items;     // Huge blocks get their own slab
+        slab = (Slab*)malloc(sizeof(Slab) + size * sizeof(Neighbor));
+        slab->size = size;
+        slab->used = 0;
+        // Keep the slab with free space at the head
+        if (pool->slabs != NULL && size == items) {
+            slab->next = pool->slabs->next;
+            pool->slabs->next = slab;
+        } else {
+            slab->next = pool->slabs;
+            pool->slabs = slab;
+        }
+    }
+    block = slab->data + slab->used;
+    slab->used += items;
+    return block;
+}
+
+static void poolFree(BlockPool *pool, Neighbor *block, int size_class) {
+    memcpy(block, &pool->free_lists[size_class], sizeof(Neighbor*));
+    pool->free_lists[size_class] = block;
+}
+
+static void poolDestroy(BlockPool *pool) {
+    while (pool->slabs != NULL) {
+        Slab *next = pool->slabs->next;
+        free(pool->slabs);
+        pool->slabs = next;
+    }
+}
+
+// ===== Updates =====
+
+DynamicGraph* createDynamicGraph(int num_vertices) {
+    DynamicGraph *graph = (DynamicGraph*)malloc(sizeof(DynamicGraph));
+    size_t slots = num_vertices > 0 ? (size_t)num_vertices : 1;
+    graph->num_vertices = num_vertices;
+    graph->num_edges = 0;
+    graph->adj = (Adjacency*)calloc(slots, sizeof(Adjacency));
+    memset(&graph->pool, 0, sizeof(BlockPool));
+    graph->components = createUnionFind(num_vertices);
+    graph->components_stale = false;
+    graph->stamp = (int*)calloc(slots, sizeof(int));
+    graph->epoch = 0;
+    graph->queue = (int*)malloc(2 * DG_RECONNECT_BUDGET * sizeof(int));
+    return graph;
+}
+
+void freeDynamicGraph(DynamicGraph *graph) {
+    if (graph == NULL) return;
+    poolDestroy(&graph->pool);
+    free(graph->adj);
+    freeUnionFind(graph->components);
+    free(graph->stamp);
+    free(graph->queue);
+    free(graph);
+}
+
+static void appendNeighbor(DynamicGraph *graph, int vertex, int dest, int weight) {
+    Adjacency *list = &graph->adj[vertex];
+    if (list->items == NULL) {
+        list->items = poolAlloc(&graph->pool, 0);
+        list->size_class = 0;
+    } else if ((size_t)list->degree == blockItems(list->size_class)) {
+        // Full: move to a block of the next size class
+        Neighbor *bigger = poolAlloc(&graph->pool, list->size_class + 1);
+        memcpy(bigger, list->items, list->degree * sizeof(Neighbor));
+        poolFree(&graph->pool, list->items, list->size_class);
+        list->items = bigger;
+        list->size_class++;
+    }
+    list->items[list->degree++] = (Neighbor){ dest, weight };
+}
+
+// Remove one copy of dest from vertex's block (order is not kept)
+static bool removeNeighbor(DynamicGraph *graph, int vertex, int dest) {
+    Adjacency *list = &graph->adj[vertex];
+    for (int i = 0; i < list->degree; i++) {
+        if (list->items[i].dest == dest) {
+            list->items[i] = list->items[--list->degree];
+            if (list->degree == 0) {
+                poolFree(&graph->pool, list->items, list->size_class);
+                list->items = NULL;
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+void dgInsertEdges(DynamicGraph *graph, const Edge *edges, long long count) {
+    for (long long e = 0; e < count; e++) {
+        int src = edges[e].src;
+        int dest = edges[e].dest;
+        appendNeighbor(graph, src, dest, edges[e].weight);
+        if (src != dest) appendNeighbor(graph, dest, src, edges[e].weight);
+        graph->num_edges++;
+        // Insertions never split components, so stale stays stale
+        if (!graph->components_stale) ufUnion(graph->components, src, dest);
+    }
+}
+
+// Bidirectional BFS from both endpoints, always growing the side that
+// has found fewer vertices; each side stops enqueuing after
+// DG_RECONNECT_BUDGET vertices. Edge scans are charged to *work and the
+// search gives up when it runs out. Returns true only if the sides meet.
+static bool stillConnected(DynamicGraph *graph, int src, int dest, long long *work) {
+    if (graph->epoch >= INT_MAX / 2 - 1) {
+        // Stamps would overflow: clear them once
+        memset(graph->stamp, 0, graph->num_vertices * sizeof(int));
+        graph->epoch = 0;
+    }
+    graph->epoch++;
+    int mark[2] = { 2 * graph->epoch, 2 * graph->epoch + 1 };
+    int *queue[2] = { graph->queue, graph->queue + DG_RECONNECT_BUDGET };
+    int head[2] = { 0, 0 };
+    int tail[2] = { 1, 1 };
+    queue[0][0] = src;
+    queue[1][0] = dest;
+    graph->stamp[src] = mark[0];
+    graph->stamp[dest] = mark[1];
+
+    while (*work > 0) {
+        int side = tail[0] <= tail[1] ? 0 : 1;
+        if (head[side] == tail[side]) side = 1 - side;
+        if (head[side] == tail[side]) return false;     // Both sides exhausted
+
+        const Adjacency *list = &graph->adj[queue[side][head[side]++]];
+        *work -= list->degree;
+        for (int i = 0; i < list->degree; i++) {
+            int v = list->items[i].dest;
+            if (graph->stamp[v] == mark[1 - side]) return true;
+            if (graph->stamp[v] != mark[side] && tail[side] < DG_RECONNECT_BUDGET) {
+                graph->stamp[v] = mark[side];
+                queue[side][tail[side]++] = v;
+            }
+        }
+    }
+    return false;
+}
+
+long long dgDeleteEdges(DynamicGraph *graph, const Edge *edges, long long count) {
+    long long deleted = 0;
+    long long num_cut = 0;
+    long long *cut = (long long*)malloc((count > 0 ? count : 1) * sizeof(long long));
+
+    for (long long e = 0; e < count; e++) {
+        int src = edges[e].src;
+        int dest = edges[e].dest;
+        if (!removeNeighbor(graph, src, dest)) continue;
+        if (src != dest) {
+            removeNeighbor(graph, dest, src);
+            cut[num_cut++] = e;
+        }
+        graph->num_edges--;
+        deleted++;
+    }
+
+    // Check after the whole batch: an endpoint pair that is still
+    // connected now keeps its component whatever else was deleted. The
+    // checks together may scan no more edges than a full recompute.
+    long long work = 2 * graph->num_edges + graph->num_vertices;
+    for (long long i = 0; i < num_cut && !graph->components_stale; i++) {
+        const Edge *edge = &edges[cut[i]];
+        if (!stillConnected(graph, edge->src, edge->dest, &work)) {
+            graph->components_stale = true;
+        }
+    }
+    free(cut);
+    return deleted;
+}
+
+// ===== Queries =====
+
+int dgCountComponents(DynamicGraph *graph) {
+    if (graph->components_stale) {
+        // Rebuild from the current edges
+        int n = graph->num_vertices;
+        freeUnionFind(graph->components);
+        graph->components = createUnionFind(n);
+        for (int u = 0; u < n; u++) {
+            Adjacency *list = &graph->adj[u];
+            for (int i = 0; i < list->degree; i++) {
+                if (u < list->items[i].dest) ufUnion(graph->components, u, list->items[i].dest);
+            }
+        }
+        graph->components_stale = false;
+    }
+    return graph->components->num_components;
+}
+
+bool dgHasCycle(DynamicGraph *graph) {
+    return graph->num_edges > (long long)graph->num_vertices - dgCountComponents(graph);
+}
+
+CSRGraph* dgToCSR(const DynamicGraph *graph) {
+    int n = graph->num_vertices;
+    long long k = 0;
+    Edge *edges = (Edge*)malloc((graph->num_edges > 0 ? graph->num_edges : 1) * sizeof(Edge));
+    for (int u = 0; u < n; u++) {
+        const Adjacency *list = &graph->adj[u];
+        for (int i = 0; i < list->degree; i++) {
+            int v = list->items[i].dest;
+            // Each edge once; a self loop is stored only once
+            if (u < v || u == v) edges[k++] = (Edge){ u, v, list->items[i].weight };
+        }
+    }
+    CSRGraph *csr = csrBuild(n, edges, k, CSR_WEIGHTED);
+    free(edges);
+    return csr;
+}
@@ -0,0 +1,96 @@
+/*
+ * dynamic_graph.h
+ * Undirected graph that changes in batches of edge inserts and deletes
+ *
+ * Each vertex owns one contiguous block of neighbors. Blocks come from
+ * a pool in power-of-two size classes: a full block moves to the next
+ * class, and freed blocks are recycled through per-class free lists,
+ * so the allocator is hardly ever called once the pool is warm.
+ *
+ * Components are tracked by a union-find that insertions update in
+ * near-constant time. Union-find cannot split sets, so after a batch of
+ * deletions a bounded bidirectional search looks for another path
+ * between the endpoints of each deleted edge; only when that fails are
+ * components recomputed, lazily, at the next query.
+ */
+
+#ifndef DYNAMIC_GRAPH_H
+#define DYNAMIC_GRAPH_H
+
+#include <stdbool.h>
+#include "csr_graph.h"
+#include "connected_components.h"
+
+#define DG_MIN_BLOCK 4              // Neighbors in the smallest block
+#define DG_SIZE_CLASSES 32
+#define DG_SLAB_BYTES (1 << 20)     // Pool grows one slab at a time
+#define DG_RECONNECT_BUDGET 4096    // Vertices per side of a deletion check
+
+typedef struct {
+    int dest;
+    int weight;
+} Neighbor;
+
+typedef struct {
+    Neighbor *items;        // Block from the pool (NULL while empty)
+    int degree;
+    int size_class;         // Block holds DG_MIN_BLOCK << size_class items
+} Adjacency;
+
+typedef struct Slab Slab;
+
+typedef struct {
+    Slab *slabs;
+    Neighbor *free_lists[DG_SIZE_CLASSES];
+} BlockPool;
+
+typedef struct {
+    int num_vertices;
+    long long num_edges;
+    Adjacency *adj;
+    BlockPool pool;
+
+    UnionFind *components;
+    bool components_stale;  // A deletion may have split a component
+
+    // Scratch for deletion checks, reused via epoch stamps
+    int *stamp;
+    int epoch;
+    int *queue;             // Two halves of DG_RECONNECT_BUDGET, one per side
+} DynamicGraph;
+
+DynamicGraph* createDynamicGraph(int num_vertices);
+void freeDynamicGraph(DynamicGraph *graph);
+
+/**
+ * @brief Insert a batch of undirected edges
+ */
+void dgInsertEdges(DynamicGraph *graph, const Edge *edges, long long count);
+
+/**
+ * @brief Delete a batch of undirected edges (one copy of each)
+ * @return Number of edges found and deleted
+ */
+long long dgDeleteEdges(DynamicGraph *graph, const Edge *edges, long long count);
+
+/**
+ * @brief Number of connected components, recomputed only if a
+ *        deletion could have split one
+ */
+int dgCountComponents(DynamicGraph *graph);
+
+/**
+ * @brief A graph with c components is a forest iff it has n - c edges
+ */
+bool dgHasCycle(DynamicGraph *graph);
+
+/**
+ * @brief Snapshot the current edges as a CSR graph for the static algorithms
+ */
+CSRGraph* dgToCSR(const DynamicGraph *graph);
+
+static inline int dgDegree(const DynamicGraph *graph, int vertex) {
+    return graph->adj[vertex].degree;
+}
+
+#endif /* DYNAMIC_GRAPH_H */
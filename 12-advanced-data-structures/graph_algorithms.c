@@ -1,15 +1,29 @@
 /*
  * graph_algorithms.c
  * Graph algorithms implementation
- * Topics: DFS, BFS, shortest path, connected components
+ * Topics: DFS, BFS, shortest path, connected components,
+ *         CSR (compressed sparse row) representation,
+ *         weighted shortest paths, multi-source BFS, dynamic graphs,
+ *         PageRank, minimum spanning trees, directed graphs (SCC,
+ *         topological sort), triangle counting
  */
 
+#define _POSIX_C_SOURCE 200809L
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <limits.h>
 #include <stdbool.h>
-
-#define MAX_VERTICES 100
+#include <time.h>
+#include "csr_graph.h"
+#include "shortest_paths.h"
+#include "connected_components.h"
+#include "multi_source_bfs.h"
+#include "dynamic_graph.h"
+#include "pagerank.h"
+#include "minimum_spanning_tree.h"
+#include "directed_graph.h"
+#include "triangle_counting.h"
 
 typedef struct Node {
     int vertex;
@@ -19,47 +33,62 @@ typedef struct Node {
 
 typedef struct {
     int num_vertices;
+    bool directed;          // addEdge stores one arc instead of two
     Node **adj_list;
 } Graph;
 
+// Ring buffer queue sized to the vertex count: BFS enqueues each
+// vertex at most once, so it can never overflow
 typedef struct {
-    int items[MAX_VERTICES];
-    int front;
-    int rear;
+    int *items;
+    int capacity;
+    int head;
+    int count;
 } Queue;
 
 // Queue operations
-void initQueue(Queue *q) {
-    q->front = -1;
-    q->rear = -1;
+Queue* createQueue(int capacity) {
+    Queue *q = (Queue*)malloc(sizeof(Queue));
+    q->items = (int*)malloc((capacity > 0 ? capacity : 1) * sizeof(int));
+    q->capacity = capacity > 0 ? capacity : 1;
+    q->head = 0;
+    q->count = 0;
+    return q;
 }
 
 bool isEmpty(Queue *q) {
-    return q->front == -1;
+    return q->count == 0;
 }
 
-void enqueue(Queue *q, int value) {
-    if (q->front == -1) {
-        q->front = 0;
+bool enqueue(Queue *q, int value) {
+    if (q->count == q->capacity) {
+        return false;
     }
-    q->rear++;
-    q->items[q->rear] = value;
+    int tail = q->head + q->count;
+    if (tail >= q->capacity) tail -= q->capacity;
+    q->items[tail] = value;
+    q->count++;
+    return true;
 }
 
 int dequeue(Queue *q) {
-    int value = q->items[q->front];
-    if (q->front >= q->rear) {
-        q->front = q->rear = -1;
-    } else {
-        q->front++;
-    }
+    int value = q->items[q->head];
+    q->head++;
+    if (q->head == q->capacity) q->head = 0;
+    q->count--;
     return value;
 }
 
+void freeQueue(Queue *q) {
+    free(q->items);
+    free(q);
+}
+
 // Create graph
 Graph* createGraph(int vertices) {
     Graph *graph = (Graph*)malloc(sizeof(Graph));
     graph->num_vertices = vertices;
+    graph->directed = false;
     graph->adj_list = (Node**)malloc(vertices * sizeof(Node*));
     
     for (int i = 0; i < vertices; i++) {
@@ -69,6 +98,13 @@ Graph* createGraph(int vertices) {
     return graph;
 }
 
+// Create graph whose edges go one way only
+Graph* createDirectedGraph(int vertices) {
+    Graph *graph = createGraph(vertices);
+    graph->directed = true;
+    return graph;
+}
+
 // Add edge
 void addEdge(Graph *graph, int src, int dest, int weight) {
     // Add edge from src to dest
@@ -77,6 +113,7 @@ void addEdge(Graph *graph, int src, int dest, int weight) {
     node->weight = weight;
     node->next = graph->adj_list[src];
     graph->adj_list[src] = node;
+    if (graph->directed) return;
     
     // For undirected graph, add edge from dest to src
     node = (Node*)malloc(sizeof(Node));
@@ -86,60 +123,131 @@ void addEdge(Graph *graph, int src, int dest, int weight) {
     graph->adj_list[dest] = node;
 }
 
-// DFS helper
-void DFSUtil(Graph *graph, int vertex, bool visited[]) {
-    visited[vertex] = true;
-    printf("%d ", vertex);
+// One suspended call of the recursive DFS: where to resume scanning
+typedef struct {
+    int vertex;
+    int parent;
+    Node *next;
+} ListDFSFrame;
+
+// Iterative DFS engine: the work stack is on the heap and grows with
+// the search depth, so deep graphs cannot overflow the native stack.
+// Callbacks (see DFSVisitor in csr_graph.h) may be NULL, and so may
+// visitor to only mark vertices; returning false from a callback stops
+// the search, and dfsVisit then returns false.
+bool dfsVisit(Graph *graph, int start, bool visited[], const DFSVisitor *visitor) {
+    static const DFSVisitor no_callbacks = { NULL, NULL, NULL, NULL };
+    if (visitor == NULL) visitor = &no_callbacks;
+    int capacity = 64;
+    int top = 0;
+    ListDFSFrame *stack = (ListDFSFrame*)malloc(capacity * sizeof(ListDFSFrame));
+    bool keep_going = true;
     
-    Node *temp = graph->adj_list[vertex];
-    while (temp != NULL) {
-        int adj_vertex = temp->vertex;
-        if (!visited[adj_vertex]) {
-            DFSUtil(graph, adj_vertex, visited);
+    visited[start] = true;
+    stack[top++] = (ListDFSFrame){ start, -1, graph->adj_list[start] };
+    if (visitor->pre_order) keep_going = visitor->pre_order(start, -1, visitor->context);
+    
+    while (keep_going && top > 0) {
+        ListDFSFrame *frame = &stack[top - 1];
+        
+        if (frame->next == NULL) {
+            int vertex = frame->vertex;
+            int parent = frame->parent;
+            top--;
+            if (visitor->post_order) {
+                keep_going = visitor->post_order(vertex, parent, visitor->context);
+            }
+            continue;
+        }
+        
+        int vertex = frame->vertex;
+        int adj_vertex = frame->next->vertex;
+        frame->next = frame->next->next;
+        
+        if (visited[adj_vertex]) {
+            if (visitor->visited_edge) {
+                keep_going = visitor->visited_edge(vertex, adj_vertex,
+                                                   frame->parent, visitor->context);
+            }
+            continue;
+        }
+        
+        visited[adj_vertex] = true;
+        if (top == capacity) {
+            capacity *= 2;
+            stack = (ListDFSFrame*)realloc(stack, capacity * sizeof(ListDFSFrame));
+        }
+        stack[top++] = (ListDFSFrame){ adj_vertex, vertex, graph->adj_list[adj_vertex] };
+        if (visitor->pre_order) {
+            keep_going = visitor->pre_order(adj_vertex, vertex, visitor->context);
         }
-        temp = temp->next;
     }
+    
+    free(stack);
+    return keep_going;
+}
+
+bool printVisit(int vertex, int parent, void *context) {
+    (void)parent;
+    (void)context;
+    printf("%d ", vertex);
+    return true;
 }
 
 // DFS traversal
 void DFS(Graph *graph, int start) {
     bool *visited = (bool*)calloc(graph->num_vertices, sizeof(bool));
+    DFSVisitor visitor = { printVisit, NULL, NULL, NULL };
     
     printf("   DFS from vertex %d: ", start);
-    DFSUtil(graph, start, visited);
+    dfsVisit(graph, start, visited, &visitor);
     printf("\n");
     
     free(visited);
 }
 
-// BFS traversal
-void BFS(Graph *graph, int start) {
+// BFS visit order (no printing); returns number of vertices reached
+int bfsOrder(Graph *graph, int start, int *order) {
     bool *visited = (bool*)calloc(graph->num_vertices, sizeof(bool));
-    Queue q;
-    initQueue(&q);
+    Queue *q = createQueue(graph->num_vertices);
+    int count = 0;
     
     visited[start] = true;
-    enqueue(&q, start);
+    enqueue(q, start);
     
-    printf("   BFS from vertex %d: ", start);
-    
-    while (!isEmpty(&q)) {
-        int vertex = dequeue(&q);
-        printf("%d ", vertex);
+    while (!isEmpty(q)) {
+        int vertex = dequeue(q);
+        if (order != NULL) order[count] = vertex;
+        count++;
         
         Node *temp = graph->adj_list[vertex];
         while (temp != NULL) {
             int adj_vertex = temp->vertex;
             if (!visited[adj_vertex]) {
                 visited[adj_vertex] = true;
-                enqueue(&q, adj_vertex);
+                enqueue(q, adj_vertex);
             }
             temp = temp->next;
         }
     }
-    printf("\n");
     
     free(visited);
+    freeQueue(q);
+    return count;
+}
+
+// BFS traversal
+void BFS(Graph *graph, int start) {
+    int *order = (int*)malloc(graph->num_vertices * sizeof(int));
+    int count = bfsOrder(graph, start, order);
+    
+    printf("   BFS from vertex %d: ", start);
+    for (int i = 0; i < count; i++) {
+        printf("%d ", order[i]);
+    }
+    printf("\n");
+    
+    free(order);
 }
 
 // Find shortest path using BFS (unweighted)
@@ -147,8 +255,7 @@ void shortestPath(Graph *graph, int start, int end) {
     bool *visited = (bool*)calloc(graph->num_vertices, sizeof(bool));
     int *distance = (int*)malloc(graph->num_vertices * sizeof(int));
     int *parent = (int*)malloc(graph->num_vertices * sizeof(int));
-    Queue q;
-    initQueue(&q);
+    Queue *q = createQueue(graph->num_vertices);
     
     for (int i = 0; i < graph->num_vertices; i++) {
         distance[i] = INT_MAX;
@@ -157,10 +264,10 @@ void shortestPath(Graph *graph, int start, int end) {
     
     visited[start] = true;
     distance[start] = 0;
-    enqueue(&q, start);
+    enqueue(q, start);
     
-    while (!isEmpty(&q)) {
-        int vertex = dequeue(&q);
+    while (!isEmpty(q)) {
+        int vertex = dequeue(q);
         
         Node *temp = graph->adj_list[vertex];
         while (temp != NULL) {
@@ -169,7 +276,7 @@ void shortestPath(Graph *graph, int start, int end) {
                 visited[adj_vertex] = true;
                 distance[adj_vertex] = distance[vertex] + 1;
                 parent[adj_vertex] = vertex;
-                enqueue(&q, adj_vertex);
+                enqueue(q, adj_vertex);
             }
             temp = temp->next;
         }
@@ -181,8 +288,8 @@ void shortestPath(Graph *graph, int start, int end) {
         printf("   Shortest path from %d to %d (distance %d): ", 
                start, end, distance[end]);
         
-        // Reconstruct path
-        int path[MAX_VERTICES];
+        // Reconstruct path (at most distance + 1 vertices)
+        int *path = (int*)malloc((distance[end] + 1) * sizeof(int));
         int path_len = 0;
         int current = end;
         
@@ -196,65 +303,79 @@ void shortestPath(Graph *graph, int start, int end) {
             if (i > 0) printf(" -> ");
         }
         printf("\n");
+        free(path);
     }
     
     free(visited);
     free(distance);
     free(parent);
+    freeQueue(q);
 }
 
-// Count connected components
+// Count connected components with union-find: no recursion, so long
+// paths cannot overflow the stack
 int countComponents(Graph *graph) {
-    bool *visited = (bool*)calloc(graph->num_vertices, sizeof(bool));
-    int count = 0;
+    UnionFind *uf = createUnionFind(graph->num_vertices);
     
     for (int i = 0; i < graph->num_vertices; i++) {
-        if (!visited[i]) {
-            DFSUtil(graph, i, visited);
-            count++;
+        Node *temp = graph->adj_list[i];
+        while (temp != NULL) {
+            ufUnion(uf, i, temp->vertex);
+            temp = temp->next;
         }
     }
     
-    free(visited);
+    int count = uf->num_components;
+    freeUnionFind(uf);
     return count;
 }
 
-// Check if graph has cycle (for undirected graph)
-bool hasCycleUtil(Graph *graph, int vertex, bool visited[], int parent) {
-    visited[vertex] = true;
-    
-    Node *temp = graph->adj_list[vertex];
-    while (temp != NULL) {
-        int adj_vertex = temp->vertex;
-        
-        if (!visited[adj_vertex]) {
-            if (hasCycleUtil(graph, adj_vertex, visited, vertex)) {
-                return true;
-            }
-        } else if (adj_vertex != parent) {
-            return true;
-        }
-        
-        temp = temp->next;
-    }
-    
-    return false;
+// An edge back to an already-visited vertex other than the one we
+// came from closes a cycle (undirected graph)
+bool stopAtCycle(int vertex, int neighbor, int parent, void *context) {
+    (void)vertex;
+    (void)context;
+    return neighbor == parent;
+}
+
+// Directed graphs: only an edge back to a vertex still on the DFS path
+// closes a cycle; edges to finished vertices are cross or forward edges
+bool enterPath(int vertex, int parent, void *context) {
+    (void)parent;
+    ((bool*)context)[vertex] = true;
+    return true;
 }
 
+bool leavePath(int vertex, int parent, void *context) {
+    (void)parent;
+    ((bool*)context)[vertex] = false;
+    return true;
+}
+
+bool stopAtBackEdge(int vertex, int neighbor, int parent, void *context) {
+    (void)vertex;
+    (void)parent;
+    return !((bool*)context)[neighbor];
+}
+
+// Check if graph has cycle
 bool hasCycle(Graph *graph) {
     bool *visited = (bool*)calloc(graph->num_vertices, sizeof(bool));
+    bool *on_path = (bool*)calloc(graph->num_vertices, sizeof(bool));
+    DFSVisitor undirected = { NULL, NULL, stopAtCycle, NULL };
+    DFSVisitor directed = { enterPath, leavePath, stopAtBackEdge, on_path };
+    DFSVisitor visitor = graph->directed ? directed : undirected;
+    bool found = false;
     
-    for (int i = 0; i < graph->num_vertices; i++) {
+    for (int i = 0; i < graph->num_vertices && !found; i++) {
         if (!visited[i]) {
-            if (hasCycleUtil(graph, i, visited, -1)) {
-                free(visited);
-                return true;
-            }
+            found = !dfsVisit(graph, i, visited, &visitor);
         }
     }
     
     free(visited);
-    return false;
+    free(on_path);
+    return found;
 }
 
 // Print graph
@@ -285,7 +406,71 @@ void freeGraph(Graph *graph) {
     free(graph);
 }
 
-int main() {
+// Convert adjacency lists to CSR. Every undirected edge is already
+// stored in both lists, so the arcs are copied one-way as they are.
+// Directed graphs keep their one-way arcs.
+CSRGraph* csrFromGraph(Graph *graph) {
+    long long num_arcs = 0;
+    for (int i = 0; i < graph->num_vertices; i++) {
+        for (Node *temp = graph->adj_list[i]; temp != NULL; temp = temp->next) {
+            num_arcs++;
+        }
+    }
+
+    Edge *arcs = (Edge*)malloc((num_arcs ? num_arcs : 1) * sizeof(Edge));
+    long long k = 0;
+    for (int i = 0; i < graph->num_vertices; i++) {
+        for (Node *temp = graph->adj_list[i]; temp != NULL; temp = temp->next) {
+            arcs[k].src = i;
+            arcs[k].dest = temp->vertex;
+            arcs[k].weight = temp->weight;
+            k++;
+        }
+    }
+
+    CSRGraph *csr = csrBuild(graph->num_vertices, arcs, num_arcs,
+                             CSR_DIRECTED | CSR_WEIGHTED);
+    csr->directed = graph->directed;  // Undirected arcs come in symmetric pairs
+    free(arcs);
+    return csr;
+}
+
+typedef struct {
+    int visited;
+    int finished;
+    int last_finished;
+} DFSCounts;
+
+bool countPreOrder(int vertex, int parent, void *context) {
+    (void)vertex;
+    (void)parent;
+    ((DFSCounts*)context)->visited++;
+    return true;
+}
+
+bool countPostOrder(int vertex, int parent, void *context) {
+    (void)parent;
+    DFSCounts *counts = (DFSCounts*)context;
+    counts->finished++;
+    counts->last_finished = vertex;
+    return true;
+}
+
+static double elapsedSeconds(struct timespec start) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (now.tv_sec - start.tv_sec) + (now.tv_nsec - start.tv_nsec) * 1e-9;
+}
+
+void printVertices(const char *label, int *vertices, int count) {
+    printf("   %s", label);
+    for (int i = 0; i < count; i++) {
+        printf("%d ", vertices[i]);
+    }
+    printf("\n");
+}
+
+int main(int argc, char *argv[]) {
     printf("=== Graph Algorithms ===\n\n");
     
     // Create graph
@@ -337,12 +522,241 @@ int main() {
     // Vertex 5 is isolated
     
     printGraph(graph2);
-    printf("   Number of connected components: %d\n", countComponents(graph2));
+    printf("   Number of connected components: %d\n\n", countComponents(graph2));
+    
+    // A path this long overflows the native stack with recursive DFS
+    int deep_vertices = 1000000;
+    printf("8. Deep Graph (%d-vertex path):\n", deep_vertices);
+    Graph *path_graph = createGraph(deep_vertices);
+    for (int i = 0; i + 1 < deep_vertices; i++) {
+        addEdge(path_graph, i, i + 1, 1);
+    }
+    bool *deep_visited = (bool*)calloc(deep_vertices, sizeof(bool));
+    DFSCounts counts = {0, 0, -1};
+    DFSVisitor counter = { countPreOrder, countPostOrder, NULL, &counts };
+    dfsVisit(path_graph, 0, deep_visited, &counter);
+    printf("   Iterative DFS: %d pre-order, %d post-order events, last finished %d\n",
+           counts.visited, counts.finished, counts.last_finished);
+    printf("   Graph has cycle: %s\n", hasCycle(path_graph) ? "Yes" : "No");
+    printf("   Connected components: %d\n", countComponents(path_graph));
+    addEdge(path_graph, deep_vertices - 1, 0, 1);
+    printf("   After closing the path into a ring, has cycle: %s\n\n",
+           hasCycle(path_graph) ? "Yes" : "No");
+    free(deep_visited);
+    freeGraph(path_graph);
+    
+    // Same algorithms on the CSR layout
+    printf("9. CSR Representation:\n");
+    CSRGraph *csr = csrFromGraph(graph);
+    int *order = (int*)malloc(csr->num_vertices * sizeof(int));
+    printf("   offsets: ");
+    for (int i = 0; i <= csr->num_vertices; i++) printf("%lld ", csr->offsets[i]);
+    printf("\n   targets: ");
+    for (long long i = 0; i < csr->num_arcs; i++) printf("%d ", csr->targets[i]);
+    printf("\n");
+    printVertices("DFS from vertex 0: ", order, csrDFS(csr, 0, order));
+    printVertices("BFS from vertex 0: ", order, csrBFS(csr, 0, order));
+    printVertices("Shortest path 0 -> 6: ", order, csrShortestPath(csr, 0, 6, order));
+    printf("   Graph has cycle: %s\n", csrHasCycle(csr) ? "Yes" : "No");
+    printf("   Connected components: %d\n", csrCountComponents(csr));
+    // All vertices as sources of one bit-parallel BFS batch
+    int *sources = (int*)malloc(csr->num_vertices * sizeof(int));
+    int *ecc = (int*)malloc(csr->num_vertices * sizeof(int));
+    for (int v = 0; v < csr->num_vertices; v++) sources[v] = v;
+    msbfsEccentricities(csr, sources, csr->num_vertices, ecc);
+    printVertices("Eccentricities (multi-source BFS): ", ecc, csr->num_vertices);
+    PageRankResult *ranks = pageRank(csr, NULL);
+    printf("   PageRank (%d iterations):", ranks->iterations);
+    for (int v = 0; v < csr->num_vertices; v++) printf(" %.3f", ranks->scores[v]);
+    printf("\n");
+    freePageRankResult(ranks);
+    
+    free(sources);
+    free(ecc);
+    CSRGraph *csr2 = csrFromGraph(graph2);
+    printf("   Disconnected graph components: %d\n\n", csrCountComponents(csr2));
+    free(order);
+    csrFree(csr);
+    csrFree(csr2);
+    
+    // Weighted shortest paths use the edge weights BFS ignores
+    printf("10. Weighted Shortest Paths:\n");
+    Graph *roads = createGraph(6);
+    addEdge(roads, 0, 1, 7);
+    addEdge(roads, 0, 2, 9);
+    addEdge(roads, 0, 5, 14);
+    addEdge(roads, 1, 2, 10);
+    addEdge(roads, 1, 3, 15);
+    addEdge(roads, 2, 3, 11);
+    addEdge(roads, 2, 5, 2);
+    addEdge(roads, 3, 4, 6);
+    addEdge(roads, 4, 5, 9);
+    CSRGraph *weighted = csrFromGraph(roads);
+    SSSPResult *sp = dijkstra(weighted, 0);
+    SSSPResult *sp_parallel = deltaStepping(weighted, 0, 5, 2);
+    int *path = (int*)malloc(weighted->num_vertices * sizeof(int));
+    for (int v = 0; v < weighted->num_vertices; v++) {
+        int len = ssspPath(sp, v, path);
+        printf("   0 -> %d: dist %2lld (delta-stepping %2lld), path: ", v,
+               sp->dist[v], sp_parallel->dist[v]);
+        for (int i = 0; i < len; i++) {
+            printf("%d%s", path[i], i < len - 1 ? " -> " : "\n");
+        }
+    }
+    printf("   Unweighted BFS path for comparison:\n");
+    shortestPath(roads, 0, 4);
+    
+    // Point-to-point queries stop once the two searches meet
+    PathQuery *query = createPathQuery(weighted);
+    int path_len;
+    long long dist = bidirectionalDijkstra(query, 0, 4, path, &path_len);
+    printf("   Bidirectional Dijkstra 0 -> 4: dist %lld, settled %lld vertices\n",
+           dist, pathQuerySettled(query));
+    printVertices("Path: ", path, path_len);
+    dist = bidirectionalBFS(query, 0, 4, path, &path_len);
+    printf("   Bidirectional BFS 0 -> 4: %lld hops\n", dist);
+    printVertices("Path: ", path, path_len);
+    freePathQuery(query);
+    
+    MSTResult *mst = mstKruskal(weighted, 2);
+    MSTResult *mst_parallel = mstBoruvka(weighted, 2);
+    printf("   Minimum spanning tree (Kruskal): ");
+    for (long long e = 0; e < mst->num_edges; e++) {
+        printf("%d-%d(%d) ", mst->edges[e].src, mst->edges[e].dest, mst->edges[e].weight);
+    }
+    printf("\n   Total weight: %lld (Boruvka: %lld)\n",
+           mst->total_weight, mst_parallel->total_weight);
+    
+    // Sorted neighbor lists intersect by merging instead of nested scans
+    csrSortNeighbors(weighted);
+    long long *corners = (long long*)malloc(weighted->num_vertices * sizeof(long long));
+    long long triangles = countTriangles(weighted, 2, corners);
+    printf("   Triangles: %lld, clustering:", triangles);
+    for (int v = 0; v < weighted->num_vertices; v++) {
+        printf(" %.2f", clusteringCoefficient(weighted, corners, v));
+    }
+    int common[8];
+    long long num_common = intersectSorted(weighted->targets + weighted->offsets[1], csrDegree(weighted, 1),
+                                           weighted->targets + weighted->offsets[2], csrDegree(weighted, 2),
+                                           common);
+    printf("\n   Common neighbors of 1 and 2 (sorted lists): %lld (", num_common);
+    for (long long i = 0; i < num_common; i++) printf("%s%d", i > 0 ? " " : "", common[i]);
+    printf(")\n\n");
+    free(corners);
+    freeMSTResult(mst);
+    freeMSTResult(mst_parallel);
+    free(path);
+    freeSSSPResult(sp);
+    freeSSSPResult(sp_parallel);
+    csrFree(weighted);
+    freeGraph(roads);
+    
+    // Edges arrive and leave in batches; components stay current
+    printf("11. Dynamic Graph:\n");
+    DynamicGraph *dynamic = createDynamicGraph(6);
+    Edge path_edges[] = { {0, 1, 1}, {1, 2, 1}, {2, 3, 1}, {4, 5, 1} };
+    dgInsertEdges(dynamic, path_edges, 4);
+    printf("   Inserted 0-1 1-2 2-3 4-5:  %d components, cycle: %s\n",
+           dgCountComponents(dynamic), dgHasCycle(dynamic) ? "Yes" : "No");
+    Edge closing[] = { {3, 0, 1}, {3, 4, 1} };
+    dgInsertEdges(dynamic, closing, 2);
+    printf("   Inserted 3-0 3-4:          %d components, cycle: %s\n",
+           dgCountComponents(dynamic), dgHasCycle(dynamic) ? "Yes" : "No");
+    Edge on_cycle[] = { {1, 2, 1} };
+    dgDeleteEdges(dynamic, on_cycle, 1);
+    printf("   Deleted 1-2 (on cycle):    %d components, cycle: %s, recompute needed: %s\n",
+           dgCountComponents(dynamic), dgHasCycle(dynamic) ? "Yes" : "No",
+           dynamic->components_stale ? "Yes" : "No");
+    Edge bridge[] = { {3, 4, 1} };
+    dgDeleteEdges(dynamic, bridge, 1);
+    printf("   Deleted 3-4 (bridge):      recompute needed: %s, ", 
+           dynamic->components_stale ? "Yes" : "No");
+    printf("%d components\n\n", dgCountComponents(dynamic));
+    freeDynamicGraph(dynamic);
+    
+    // Build dependencies: an arc u -> v means u must be built before v
+    printf("12. Directed Graphs:\n");
+    Graph *deps = createDirectedGraph(6);
+    addEdge(deps, 0, 1, 1);
+    addEdge(deps, 0, 2, 1);
+    addEdge(deps, 1, 3, 1);
+    addEdge(deps, 2, 3, 1);
+    addEdge(deps, 3, 4, 1);
+    addEdge(deps, 5, 4, 1);
+    CSRGraph *dag = csrFromGraph(deps);
+    int build_order[6];
+    int levels = 0;
+    bool acyclic = topologicalSort(dag, 2, build_order, &levels);
+    printf("   Dependencies 0->1 0->2 1->3 2->3 3->4 5->4, cycle: %s\n",
+           hasCycle(deps) ? "Yes" : "No");
+    printf("   Build order (%d levels): ", levels);
+    for (int i = 0; acyclic && i < 6; i++) printf("%d ", build_order[i]);
+    printf("\n");
+    csrFree(dag);
+    
+    addEdge(deps, 4, 1, 1);
+    dag = csrFromGraph(deps);
+    int num_scc = 0;
+    int *scc = tarjanSCC(dag, &num_scc);
+    printf("   After adding 4->1, cycle: %s, topological sort: %s\n",
+           hasCycle(deps) ? "Yes" : "No",
+           topologicalSort(dag, 2, NULL, NULL) ? "OK" : "fails");
+    printf("   Strongly connected components (%d): ", num_scc);
+    for (int v = 0; v < 6; v++) printf("%d:%d ", v, scc[v]);
+    printf("\n\n");
+    free(scc);
+    csrFree(dag);
+    freeGraph(deps);
+    
+    // Build time at scale: linked Nodes vs. two-pass CSR
+    int big_vertices = argc > 1 ? atoi(argv[1]) : 1000000;
+    long long big_edges = argc > 2 ? atoll(argv[2]) : 5000000LL;
+    printf("13. Large Random Graph (%d vertices, %lld edges):\n", big_vertices, big_edges);
+    Edge *edges = (Edge*)malloc(big_edges * sizeof(Edge));
+    unsigned long long seed = 88172645463325252ULL;
+    for (long long e = 0; e < big_edges; e++) {
+        seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+        edges[e].src = (int)(seed % big_vertices);
+        edges[e].dest = (int)((seed >> 32) % big_vertices);
+        edges[e].weight = 1;
+    }
+    
+    // CSR runs first: freeing millions of Nodes would slow later mallocs.
+    // Both BFS versions use one vertex-count-sized frontier allocation.
+    struct timespec start;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    CSRGraph *big = csrBuild(big_vertices, edges, big_edges, 0);
+    printf("   CSR build (two passes):      %.3f s\n", elapsedSeconds(start));
+    
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int reached = csrBFS(big, 0, NULL);
+    printf("   CSR BFS:                     %.3f s (%d vertices reached)\n",
+           elapsedSeconds(start), reached);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int big_components = csrCountComponents(big);
+    printf("   CSR components:              %.3f s (%d components)\n",
+           elapsedSeconds(start), big_components);
+    csrFree(big);
+    
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    Graph *list_graph = createGraph(big_vertices);
+    for (long long e = 0; e < big_edges; e++) {
+        addEdge(list_graph, edges[e].src, edges[e].dest, edges[e].weight);
+    }
+    printf("   Linked-list build (addEdge): %.3f s\n", elapsedSeconds(start));
+    free(edges);
+    
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    reached = bfsOrder(list_graph, 0, NULL);
+    printf("   Linked-list BFS:             %.3f s (%d vertices reached)\n",
+           elapsedSeconds(start), reached);
+    freeGraph(list_graph);
     
     // Cleanup
     freeGraph(graph);
     freeGraph(graph2);
     printf("\n   Memory freed\n");
+    printf("   Usage: ./graph_algorithms [vertices] [edges]\n");
     
     return 0;
 }
@@ -0,0 +1,1003 @@
+/*
+ * graph_benchmark.c
+ * Benchmarks for the CSR graph algorithms
+ * Topics: synthetic graphs, timing, checking parallel results against
+ *         sequential ones
+ *
+ * Usage: ./graph_benchmark [all|sssp|p2p|mst|dag|triangles|bfs|msbfs|cc|dynamic|pagerank|io] [scale] [max_threads]
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include "csr_graph.h"
+#include "shortest_paths.h"
+#include "parallel_bfs.h"
+#include "multi_source_bfs.h"
+#include "connected_components.h"
+#include "graph_io.h"
+#include "graph_generators.h"
+#include "dynamic_graph.h"
+#include "pagerank.h"
+#include "minimum_spanning_tree.h"
+#include "directed_graph.h"
+#include "triangle_counting.h"
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Random vertex with at least one edge, or -1 if the graph has no arcs.
+// After a few missed draws, scans on from a random vertex instead.
+static int pickNonIsolated(const CSRGraph *graph, uint64_t *seed) {
+    int n = graph->num_vertices;
+    if (n == 0 || graph->num_arcs == 0) return -1;
+    for (int tries = 0; tries < 64; tries++) {
+        int v = (int)(genRandom(seed) % n);
+        if (csrDegree(graph, v) > 0) return v;
+    }
+    int start = (int)(genRandom(seed) % n);
+    for (int i = 0; i < n; i++) {
+        int v = (start + i) % n;
+        if (csrDegree(graph, v) > 0) return v;
+    }
+    return -1;
+}
+
+// ===== Shortest paths =====
+
+// Unreachable vertices have no parent, and every other parent chain
+// ends at the source (no cycles)
+static bool parentsReachSource(const SSSPResult *result) {
+    int n = result->num_vertices;
+    char *state = (char*)calloc(n > 0 ? n : 1, 1);  // 1: on this walk, 2: reaches source, 3: not
+    state[result->source] = 2;
+    bool ok = result->parent[result->source] == -1;
+    for (int v = 0; v < n; v++) {
+        if (result->dist[v] == SSSP_INF) {
+            ok = ok && result->parent[v] == -1;
+            continue;
+        }
+        int u = v;
+        while (u >= 0 && state[u] == 0) {
+            state[u] = 1;
+            u = result->parent[u];
+        }
+        bool good = u >= 0 && state[u] == 2;
+        for (int w = v; w >= 0 && state[w] == 1; w = result->parent[w]) state[w] = good ? 2 : 3;
+        ok = ok && good;
+    }
+    free(state);
+    return ok;
+}
+
+static void benchmarkSSSPOn(const char *name, CSRGraph *graph, int max_threads) {
+    printf("   %s: %d vertices, %lld arcs\n", name, graph->num_vertices, graph->num_arcs);
+
+    double start = nowSeconds();
+    SSSPResult *reference = dijkstra(graph, 0);
+    double t_dijkstra = nowSeconds() - start;
+    printf("   %-26s %8.3f s %10.1f M arcs/s\n", "Dijkstra (radix heap)",
+           t_dijkstra, graph->num_arcs / t_dijkstra / 1e6);
+
+    // Mean edge weight is 50.5; a bucket of ~2 average edges works well
+    long long delta = 100;
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        start = nowSeconds();
+        SSSPResult *result = deltaStepping(graph, 0, delta, threads);
+        double t = nowSeconds() - start;
+
+        int mismatches = parentsReachSource(result) ? 0 : 1;
+        for (int v = 0; v < graph->num_vertices; v++) {
+            if (result->dist[v] != reference->dist[v]) mismatches++;
+        }
+        char label[64];
+        snprintf(label, sizeof(label), "Delta-stepping (%d thr)", threads);
+        printf("   %-26s %8.3f s %10.1f M arcs/s  %s\n", label, t,
+               graph->num_arcs / t / 1e6, mismatches == 0 ? "OK" : "MISMATCH");
+        freeSSSPResult(result);
+    }
+
+    long long farthest = 0;
+    for (int v = 0; v < graph->num_vertices; v++) {
+        if (reference->dist[v] != SSSP_INF && reference->dist[v] > farthest) {
+            farthest = reference->dist[v];
+        }
+    }
+    printf("   Largest finite distance from 0: %lld\n\n", farthest);
+    freeSSSPResult(reference);
+}
+
+void benchmarkSSSP(int scale, int max_threads) {
+    printf("Weighted Shortest Paths (scale %d):\n", scale);
+
+    double start = nowSeconds();
+    CSRGraph *grid = makeGrid2D(1 << (scale / 2), 1);
+    printf("   Grid generated in %.3f s\n", nowSeconds() - start);
+    benchmarkSSSPOn("Grid", grid, max_threads);
+    csrFree(grid);
+
+    start = nowSeconds();
+    CSRGraph *rmat = makeRMAT(scale, 16, 2);
+    printf("   R-MAT generated in %.3f s\n", nowSeconds() - start);
+    benchmarkSSSPOn("R-MAT", rmat, max_threads);
+    csrFree(rmat);
+
+    // s -> a (1), a <-> b (0): b is numbered before s, so parents taken
+    // in vertex order alone would point a and b at each other
+    Edge cycle_edges[] = { { 2, 0, 1 }, { 0, 1, 0 }, { 1, 0, 0 } };
+    CSRGraph *cycle = csrBuild(3, cycle_edges, 3, CSR_DIRECTED | CSR_WEIGHTED);
+    bool ok = true;
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        SSSPResult *result = deltaStepping(cycle, 2, 1, threads);
+        ok = ok && result->dist[0] == 1 && result->dist[1] == 1 && parentsReachSource(result);
+        freeSSSPResult(result);
+    }
+    printf("   %-26s %s\n\n", "Zero-weight cycle parents", ok ? "OK" : "MISMATCH");
+    csrFree(cycle);
+}
+
+// ===== Minimum spanning trees =====
+
+static void benchmarkMSTOn(const char *name, CSRGraph *graph, int max_threads) {
+    printf("   %s: %d vertices, %lld arcs\n", name, graph->num_vertices, graph->num_arcs);
+    int components;
+    free(componentsUnionFind(graph, &components));
+    long long expected_edges = (long long)graph->num_vertices - components;
+
+    long long reference = -1;
+    for (int algorithm = 0; algorithm < 2; algorithm++) {
+        for (int threads = 1; threads <= max_threads; threads *= 2) {
+            double start = nowSeconds();
+            MSTResult *mst = algorithm == 0 ? mstKruskal(graph, threads)
+                                            : mstBoruvka(graph, threads);
+            double t = nowSeconds() - start;
+            if (reference < 0) reference = mst->total_weight;
+
+            char label[64];
+            snprintf(label, sizeof(label), "%s (%d thr)", algorithm == 0 ? "Kruskal" : "Boruvka",
+                     threads);
+            printf("   %-20s %8.3f s  weight %lld, %lld edges  %s\n", label, t,
+                   mst->total_weight, mst->num_edges,
+                   mst->total_weight == reference && mst->num_edges == expected_edges
+                       ? "OK" : "MISMATCH");
+            freeMSTResult(mst);
+        }
+    }
+    printf("\n");
+}
+
+void benchmarkMST(int scale, int max_threads) {
+    printf("Minimum Spanning Trees (scale %d):\n", scale);
+    CSRGraph *uniform = makeUniform(scale, 8, 37);
+    benchmarkMSTOn("Uniform random", uniform, max_threads);
+    csrFree(uniform);
+
+    CSRGraph *kron = makeKronecker(scale, 8, 41);
+    benchmarkMSTOn("Kronecker", kron, max_threads);
+    csrFree(kron);
+}
+
+// ===== Directed graphs =====
+
+// Dependency-like DAG: every vertex depends on a few vertices at most
+// span positions earlier, then labels are shuffled so that vertex ids
+// say nothing about the order
+static CSRGraph* makeRandomDAG(int scale, int degree, int span, uint64_t seed) {
+    int n = 1 << scale;
+    long long m = (long long)n * degree;
+    int *label = (int*)malloc(n * sizeof(int));
+    for (int v = 0; v < n; v++) label[v] = v;
+    for (int v = n - 1; v > 0; v--) {
+        int u = (int)(genRandom(&seed) % (uint64_t)(v + 1));
+        int tmp = label[v];
+        label[v] = label[u];
+        label[u] = tmp;
+    }
+
+    Edge *edges = (Edge*)malloc(m * sizeof(Edge));
+    for (long long e = 0; e < m; e++) {
+        int src = (int)(genRandom(&seed) % (uint64_t)(n - 1));
+        int dest = src + 1 + (int)(genRandom(&seed) % (uint64_t)span);
+        if (dest >= n) dest = n - 1;
+        edges[e] = (Edge){ label[src], label[dest], 1 };
+    }
+    CSRGraph *graph = csrBuild(n, edges, m, CSR_DIRECTED);
+    free(edges);
+    free(label);
+    return graph;
+}
+
+// Every arc must go from an earlier position to a later one
+static bool isTopologicalOrder(const CSRGraph *graph, const int *order) {
+    int n = graph->num_vertices;
+    int *position = (int*)malloc(n * sizeof(int));
+    for (int v = 0; v < n; v++) position[v] = -1;
+    for (int i = 0; i < n; i++) position[order[i]] = i;
+    bool ok = true;
+    for (int u = 0; u < n && ok; u++) {
+        for (long long i = graph->offsets[u]; i < graph->offsets[u + 1]; i++) {
+            if (position[u] < 0 || position[u] >= position[graph->targets[i]]) {
+                ok = false;
+                break;
+            }
+        }
+    }
+    free(position);
+    return ok;
+}
+
+void benchmarkDirected(int scale, int max_threads) {
+    printf("Directed Graphs (scale %d):\n", scale);
+    double start = nowSeconds();
+    CSRGraph *dag = makeRandomDAG(scale, 4, 4096, 43);
+    printf("   Random DAG: %d vertices, %lld arcs (generated in %.3f s)\n",
+           dag->num_vertices, dag->num_arcs, nowSeconds() - start);
+
+    int *order = (int*)malloc(dag->num_vertices * sizeof(int));
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        int levels = 0;
+        start = nowSeconds();
+        bool acyclic = topologicalSort(dag, threads, order, &levels);
+        double t = nowSeconds() - start;
+        char label[64];
+        snprintf(label, sizeof(label), "Kahn levels (%d thr)", threads);
+        printf("   %-22s %8.3f s %10.1f M arcs/s  %d levels  %s\n", label, t,
+               dag->num_arcs / t / 1e6, levels,
+               acyclic && isTopologicalOrder(dag, order) ? "OK" : "MISMATCH");
+    }
+    free(order);
+
+    int components;
+    start = nowSeconds();
+    free(tarjanSCC(dag, &components));
+    double t = nowSeconds() - start;
+    printf("   %-22s %8.3f s %10.1f M arcs/s  %d components  %s\n\n", "Tarjan SCC", t,
+           dag->num_arcs / t / 1e6, components,
+           components == dag->num_vertices ? "OK" : "MISMATCH");
+    csrFree(dag);
+
+    // Upward R-MAT arcs plus a quarter of the downward ones: a giant
+    // component and many small ones. Check the SCC ids against the
+    // condensation order they promise.
+    CSRGraph *rmat = makeRMAT(scale, 8, 47);
+    Edge *arcs = (Edge*)malloc(rmat->num_arcs * sizeof(Edge));
+    long long num_arcs = 0;
+    uint64_t seed = 53;
+    for (int u = 0; u < rmat->num_vertices; u++) {
+        for (long long i = rmat->offsets[u]; i < rmat->offsets[u + 1]; i++) {
+            if (rmat->targets[i] > u || genRandom(&seed) % 4 == 0) {
+                arcs[num_arcs++] = (Edge){ u, rmat->targets[i], 1 };
+            }
+        }
+    }
+    CSRGraph *directed = csrBuild(rmat->num_vertices, arcs, num_arcs, CSR_DIRECTED);
+    free(arcs);
+    csrFree(rmat);
+
+    start = nowSeconds();
+    int *comp = tarjanSCC(directed, &components);
+    t = nowSeconds() - start;
+    int *size = (int*)calloc(components, sizeof(int));
+    int largest = 0;
+    bool ok = true;
+    for (int u = 0; u < directed->num_vertices; u++) {
+        if (++size[comp[u]] > largest) largest = size[comp[u]];
+        for (long long i = directed->offsets[u]; i < directed->offsets[u + 1]; i++) {
+            if (comp[directed->targets[i]] > comp[u]) ok = false;
+        }
+    }
+    printf("   Directed R-MAT: %d vertices, %lld arcs\n", directed->num_vertices,
+           directed->num_arcs);
+    printf("   %-22s %8.3f s %10.1f M arcs/s  %d components, largest %d  %s\n\n",
+           "Tarjan SCC", t, directed->num_arcs / t / 1e6, components, largest,
+           ok ? "OK" : "MISMATCH");
+    free(size);
+    free(comp);
+    csrFree(directed);
+}
+
+// ===== Triangles =====
+
+static void benchmarkTrianglesOn(const char *name, CSRGraph *graph, int max_threads) {
+    printf("   %s: %d vertices, %lld arcs\n", name, graph->num_vertices, graph->num_arcs);
+    long long reference = -1;
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        double start = nowSeconds();
+        long long triangles = countTriangles(graph, threads, NULL);
+        double t = nowSeconds() - start;
+        if (reference < 0) reference = triangles;
+        char label[64];
+        snprintf(label, sizeof(label), "Count (%d thr)", threads);
+        printf("   %-22s %8.3f s %10.1f M triangles/s %10.1f M arcs/s  %s\n", label, t,
+               triangles / t / 1e6, graph->num_arcs / t / 1e6,
+               triangles == reference ? "OK" : "MISMATCH");
+    }
+
+    // Every triangle is credited to its three corners
+    long long *per_vertex = (long long*)malloc(graph->num_vertices * sizeof(long long));
+    double start = nowSeconds();
+    countTriangles(graph, max_threads, per_vertex);
+    double t = nowSeconds() - start;
+    long long corners = 0;
+    double clustering = 0;
+    for (int v = 0; v < graph->num_vertices; v++) {
+        corners += per_vertex[v];
+        clustering += clusteringCoefficient(graph, per_vertex, v);
+    }
+    char label[64];
+    snprintf(label, sizeof(label), "Per vertex (%d thr)", max_threads);
+    printf("   %-22s %8.3f s  %lld triangles, mean clustering %.4f  %s\n\n", label, t,
+           reference, clustering / graph->num_vertices,
+           corners == 3 * reference ? "OK" : "MISMATCH");
+    free(per_vertex);
+}
+
+void benchmarkTriangles(int scale, int max_threads) {
+    printf("Triangle Counting (scale %d):\n", scale);
+    CSRGraph *rmat = makeRMAT(scale, 16, 59);
+    benchmarkTrianglesOn("R-MAT", rmat, max_threads);
+    csrFree(rmat);
+
+    CSRGraph *kron = makeKronecker(scale, 16, 61);
+    benchmarkTrianglesOn("Kronecker", kron, max_threads);
+    csrFree(kron);
+}
+
+// ===== Breadth first search =====
+
+// Level of every vertex from a plain sequential BFS (-1 if unreached)
+static int* referenceDepths(const CSRGraph *graph, int source) {
+    int n = graph->num_vertices;
+    int *depth = (int*)malloc(n * sizeof(int));
+    int *queue = (int*)malloc(n * sizeof(int));
+    int head = 0, tail = 0;
+    for (int i = 0; i < n; i++) depth[i] = -1;
+    depth[source] = 0;
+    queue[tail++] = source;
+    while (head < tail) {
+        int u = queue[head++];
+        for (long long i = graph->offsets[u]; i < graph->offsets[u + 1]; i++) {
+            int v = graph->targets[i];
+            if (depth[v] == -1) {
+                depth[v] = depth[u] + 1;
+                queue[tail++] = v;
+            }
+        }
+    }
+    free(queue);
+    return depth;
+}
+
+// A parent array is a valid BFS tree if every reached vertex hangs
+// off a neighbor exactly one level closer to the source
+static bool validBFSTree(const CSRGraph *graph, int source, const int *parent,
+                         const int *depth) {
+    for (int v = 0; v < graph->num_vertices; v++) {
+        if ((parent[v] == -1) != (depth[v] == -1)) return false;
+        if (parent[v] == -1 || v == source) continue;
+        int u = parent[v];
+        if (depth[u] != depth[v] - 1) return false;
+        bool adjacent = false;
+        for (long long i = graph->offsets[v]; i < graph->offsets[v + 1] && !adjacent; i++) {
+            adjacent = graph->targets[i] == u;
+        }
+        if (!adjacent) return false;
+    }
+    return parent[source] == source;
+}
+
+void benchmarkBFS(int scale, int max_threads) {
+    printf("Direction-Optimizing BFS (R-MAT scale %d, edge factor 16):\n", scale);
+
+    double start = nowSeconds();
+    CSRGraph *graph = makeRMAT(scale, 16, 3);
+    printf("   Generated in %.3f s: %d vertices, %lld arcs\n",
+           nowSeconds() - start, graph->num_vertices, graph->num_arcs);
+
+    // Sources with at least one edge, fixed for every thread count
+    enum { NUM_SOURCES = 8 };
+    int sources[NUM_SOURCES];
+    uint64_t seed = 99;
+    for (int i = 0; i < NUM_SOURCES; i++) sources[i] = pickNonIsolated(graph, &seed);
+    if (sources[0] < 0) {
+        printf("   No edges, skipped\n\n");
+        csrFree(graph);
+        return;
+    }
+
+    int *parent = (int*)malloc(graph->num_vertices * sizeof(int));
+    double seq_time = 0;
+    long long seq_edges = 0;
+    for (int i = 0; i < NUM_SOURCES; i++) {
+        start = nowSeconds();
+        csrBFS(graph, sources[i], NULL);
+        seq_time += nowSeconds() - start;
+        BFSStats stats;
+        parallelBFS(graph, sources[i], 1, parent, &stats);
+        seq_edges += stats.edges_in_component / 2;
+    }
+    printf("   %-24s %8.4f s/search %10.1f MTEPS\n", "Sequential top-down",
+           seq_time / NUM_SOURCES, seq_edges / seq_time / 1e6);
+
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        double total = 0;
+        long long edges = 0;
+        bool valid = true;
+        BFSStats stats;
+        for (int i = 0; i < NUM_SOURCES; i++) {
+            start = nowSeconds();
+            parallelBFS(graph, sources[i], threads, parent, &stats);
+            total += nowSeconds() - start;
+            edges += stats.edges_in_component / 2;
+            if (i == 0) {
+                int *depth = referenceDepths(graph, sources[i]);
+                valid = validBFSTree(graph, sources[i], parent, depth);
+                free(depth);
+            }
+        }
+        char label[64];
+        snprintf(label, sizeof(label), "Parallel (%d thr)", threads);
+        printf("   %-24s %8.4f s/search %10.1f MTEPS  %s (levels %d: %d top-down, %d bottom-up)\n",
+               label, total / NUM_SOURCES, edges / total / 1e6, valid ? "OK" : "INVALID",
+               stats.levels, stats.top_down_steps, stats.bottom_up_steps);
+    }
+    printf("\n");
+
+    free(parent);
+    csrFree(graph);
+}
+
+// ===== Point-to-point queries =====
+
+// Random queries; distances are checked against full Dijkstra
+// grid is NULL unless the graph came from makeGrid2D
+static void benchmarkQueriesOn(const char *name, CSRGraph *graph, bool weighted,
+                               GridLayout *grid, int num_queries) {
+    int n = graph->num_vertices;
+    printf("   %s: %d vertices, %lld arcs, %d random queries\n",
+           name, n, graph->num_arcs, num_queries);
+
+    if (graph->num_arcs == 0) {
+        printf("   No edges, skipped\n\n");
+        return;
+    }
+    int *pairs = (int*)malloc(2 * num_queries * sizeof(int));
+    uint64_t seed = 31;
+    for (int i = 0; i < 2 * num_queries; i++) pairs[i] = pickNonIsolated(graph, &seed);
+
+    // Reference: one full single-source search per query
+    long long *expected = (long long*)malloc(num_queries * sizeof(long long));
+    double start = nowSeconds();
+    for (int q = 0; q < num_queries; q++) {
+        if (weighted) {
+            SSSPResult *result = dijkstra(graph, pairs[2 * q]);
+            expected[q] = result->dist[pairs[2 * q + 1]];
+            freeSSSPResult(result);
+        } else {
+            int *depth = referenceDepths(graph, pairs[2 * q]);
+            expected[q] = depth[pairs[2 * q + 1]] >= 0 ? depth[pairs[2 * q + 1]] : SSSP_INF;
+            free(depth);
+        }
+    }
+    double t_full = nowSeconds() - start;
+    printf("   %-26s %9.3f ms/query\n", weighted ? "Full Dijkstra" : "Full BFS",
+           t_full / num_queries * 1e3);
+
+    enum { BIDIRECTIONAL_BFS, BIDIRECTIONAL_DIJKSTRA, A_STAR };
+    static const char *labels[] = { "Bidirectional BFS", "Bidirectional Dijkstra",
+                                     "A* (grid heuristic)" };
+    PathQuery *query = createPathQuery(graph);
+    int *path = (int*)malloc(n * sizeof(int));
+    for (int k = BIDIRECTIONAL_BFS; k <= A_STAR; k++) {
+        if ((k == BIDIRECTIONAL_BFS) == weighted || (k == A_STAR && grid == NULL)) continue;
+        long long settled = 0;
+        bool ok = true;
+        start = nowSeconds();
+        for (int q = 0; q < num_queries; q++) {
+            int source = pairs[2 * q], target = pairs[2 * q + 1], path_len;
+            long long dist;
+            if (k == BIDIRECTIONAL_BFS) {
+                dist = bidirectionalBFS(query, source, target, path, &path_len);
+            } else if (k == BIDIRECTIONAL_DIJKSTRA) {
+                dist = bidirectionalDijkstra(query, source, target, path, &path_len);
+            } else {
+                dist = aStarSearch(query, source, target, gridHeuristic, grid, path, &path_len);
+            }
+            settled += pathQuerySettled(query);
+            ok = ok && dist == expected[q];
+        }
+        double t = nowSeconds() - start;
+        printf("   %-26s %9.3f ms/query %10.0f settled/query  %s (%.0fx)\n",
+               labels[k], t / num_queries * 1e3, (double)settled / num_queries,
+               ok ? "OK" : "MISMATCH", t_full / t);
+    }
+    printf("\n");
+
+    free(path);
+    freePathQuery(query);
+    free(expected);
+    free(pairs);
+}
+
+void benchmarkPointToPoint(int scale) {
+    printf("Point-to-Point Shortest Paths (scale %d):\n", scale);
+    int side = 1 << (scale / 2);
+    CSRGraph *grid = makeGrid2D(side, 1);
+    GridLayout layout = { side, 1 };
+    benchmarkQueriesOn("Grid", grid, true, &layout, 20);
+    csrFree(grid);
+
+    CSRGraph *kron = makeKronecker(scale, 16, 29);
+    benchmarkQueriesOn("Kronecker (weighted)", kron, true, NULL, 20);
+    benchmarkQueriesOn("Kronecker (hops)", kron, false, NULL, 20);
+    csrFree(kron);
+}
+
+// ===== Batched BFS queries =====
+
+void benchmarkMultiSourceBFS(int scale, int num_sources) {
+    printf("Multi-Source BFS (Kronecker scale %d, edge factor 16, %d sources):\n",
+           scale, num_sources);
+
+    double start = nowSeconds();
+    CSRGraph *graph = makeKronecker(scale, 16, 13);
+    printf("   Generated in %.3f s: %d vertices, %lld arcs\n",
+           nowSeconds() - start, graph->num_vertices, graph->num_arcs);
+
+    if (graph->num_arcs == 0) {
+        printf("   No edges, skipped\n\n");
+        csrFree(graph);
+        return;
+    }
+    int *sources = (int*)malloc(num_sources * sizeof(int));
+    uint64_t seed = 17;
+    for (int i = 0; i < num_sources; i++) sources[i] = pickNonIsolated(graph, &seed);
+
+    // One plain BFS per source
+    int *expected = (int*)malloc(num_sources * sizeof(int));
+    start = nowSeconds();
+    for (int i = 0; i < num_sources; i++) {
+        int *depth = referenceDepths(graph, sources[i]);
+        expected[i] = 0;
+        for (int v = 0; v < graph->num_vertices; v++) {
+            if (depth[v] > expected[i]) expected[i] = depth[v];
+        }
+        free(depth);
+    }
+    double t_single = nowSeconds() - start;
+    printf("   %-28s %8.3f s %10.1f queries/s\n", "One BFS per source",
+           t_single, num_sources / t_single);
+
+    int *ecc = (int*)malloc(num_sources * sizeof(int));
+    start = nowSeconds();
+    msbfsEccentricities(graph, sources, num_sources, ecc);
+    double t_batch = nowSeconds() - start;
+    bool same = memcmp(ecc, expected, num_sources * sizeof(int)) == 0;
+    printf("   %-28s %8.3f s %10.1f queries/s  %s (%.1fx)\n", "MS-BFS eccentricities",
+           t_batch, num_sources / t_batch, same ? "OK" : "MISMATCH", t_single / t_batch);
+
+    // Full distance rows for one batch, checked against plain BFS
+    int batch = num_sources < MSBFS_BATCH ? num_sources : MSBFS_BATCH;
+    int n = graph->num_vertices;
+    int *dist = (int*)malloc((long long)batch * n * sizeof(int));
+    start = nowSeconds();
+    msbfsDistances(graph, sources, batch, dist);
+    double t_dist = nowSeconds() - start;
+    same = true;
+    for (int i = 0; i < batch && same; i++) {
+        int *depth = referenceDepths(graph, sources[i]);
+        same = memcmp(depth, dist + (long long)i * n, n * sizeof(int)) == 0;
+        free(depth);
+    }
+    printf("   %-28s %8.3f s %10.1f queries/s  %s\n", "MS-BFS distances (1 batch)",
+           t_dist, batch / t_dist, same ? "OK" : "MISMATCH");
+    printf("\n");
+
+    free(dist);
+    free(ecc);
+    free(expected);
+    free(sources);
+    csrFree(graph);
+}
+
+// ===== Dynamic updates =====
+
+// Batches that insert fresh uniform edges and delete the oldest ones,
+// keeping the edge count steady; components are queried after each
+void benchmarkDynamic(int scale, int num_batches) {
+    int n = 1 << scale;
+    long long live = 8LL * n;
+    long long batch = 64;
+    long long total = live + batch * num_batches;
+    printf("Dynamic Graph (%d vertices, %lld edges, %d batches of %lld inserts + %lld deletes):\n",
+           n, live, num_batches, batch, batch);
+
+    // Edge e is inserted first and deleted by the batch that inserts e + live
+    Edge *edges = (Edge*)malloc(total * sizeof(Edge));
+    uint64_t seed = 21;
+    for (long long e = 0; e < total; e++) {
+        edges[e] = (Edge){ (int)(genRandom(&seed) % n), (int)(genRandom(&seed) % n), 1 };
+    }
+
+    double start = nowSeconds();
+    DynamicGraph *graph = createDynamicGraph(n);
+    dgInsertEdges(graph, edges, live);
+    printf("   %-30s %8.3f s  %d components\n", "Initial inserts",
+           nowSeconds() - start, dgCountComponents(graph));
+
+    int recomputes = 0;
+    start = nowSeconds();
+    for (int b = 0; b < num_batches; b++) {
+        dgInsertEdges(graph, edges + live + b * batch, batch);
+        dgDeleteEdges(graph, edges + b * batch, batch);
+        recomputes += graph->components_stale;
+        dgCountComponents(graph);
+    }
+    double t_dynamic = nowSeconds() - start;
+    printf("   %-30s %8.4f s/batch  (%d of %d batches recomputed components)\n",
+           "Incremental updates + query", t_dynamic / num_batches, recomputes, num_batches);
+
+    // Baseline: rebuild CSR and recompute components for the live window
+    start = nowSeconds();
+    CSRGraph *rebuilt = csrBuild(n, edges + batch * num_batches, live, 0);
+    int reference_count;
+    free(componentsUnionFind(rebuilt, &reference_count));
+    double t_rebuild = nowSeconds() - start;
+    csrFree(rebuilt);
+    printf("   %-30s %8.4f s/batch  (%.0fx slower)\n", "Rebuild CSR + union-find",
+           t_rebuild, t_rebuild / (t_dynamic / num_batches));
+    printf("   Components after updates: %d (rebuild: %d)  %s\n\n", dgCountComponents(graph),
+           reference_count, dgCountComponents(graph) == reference_count ? "OK" : "MISMATCH");
+
+    freeDynamicGraph(graph);
+    free(edges);
+}
+
+// ===== PageRank =====
+
+void benchmarkPageRank(int scale, int max_threads) {
+    printf("PageRank (directed R-MAT scale %d, edge factor 16):\n", scale);
+    int n = 1 << scale;
+    long long num_edges = 16LL * n;
+
+    double start = nowSeconds();
+    Edge *edges = (Edge*)malloc(num_edges * sizeof(Edge));
+    uint64_t seed = 23;
+    generateRMATEdges(edges, num_edges, scale, &seed);
+    CSRGraph *graph = csrBuild(n, edges, num_edges, CSR_DIRECTED);
+    free(edges);
+    printf("   Generated in %.3f s: %d vertices, %lld arcs\n",
+           nowSeconds() - start, graph->num_vertices, graph->num_arcs);
+
+    PageRankOptions options = pageRankDefaults();
+    options.tolerance = 1e-4;   // Reachable in float32 as well
+    PageRankResult *reference = NULL;
+
+    for (int use_float = 0; use_float <= 1; use_float++) {
+        for (int threads = 1; threads <= max_threads; threads *= 2) {
+            options.num_threads = threads;
+            options.use_float = use_float;
+            start = nowSeconds();
+            PageRankResult *result = pageRank(graph, &options);
+            double t_total = nowSeconds() - start;
+
+            double sweep = 0;
+            for (int i = 0; i < result->iterations; i++) sweep += result->iteration_seconds[i];
+            sweep /= result->iterations;
+
+            double max_diff = 0;
+            if (reference != NULL) {
+                for (int v = 0; v < n; v++) {
+                    double diff = fabs(result->scores[v] - reference->scores[v]);
+                    if (diff > max_diff) max_diff = diff;
+                }
+            }
+            char label[64];
+            snprintf(label, sizeof(label), "%s (%d thr)", use_float ? "float32" : "float64",
+                     threads);
+            printf("   %-18s %3d iter %8.4f s/iter %7.2f GB/s %8.3f s total  max diff %.1e\n",
+                   label, result->iterations, sweep, result->bytes_per_iteration / sweep / 1e9,
+                   t_total, max_diff);
+
+            if (reference == NULL) {
+                reference = result;
+            } else {
+                freePageRankResult(result);
+            }
+        }
+    }
+
+    printf("   Per-iteration seconds (float64, 1 thread):");
+    for (int i = 0; i < reference->iterations; i++) {
+        printf("%s%.4f", i % 8 == 0 ? "\n      " : " ", reference->iteration_seconds[i]);
+    }
+    printf("\n\n");
+
+    freePageRankResult(reference);
+    csrFree(graph);
+}
+
+// ===== Connected components =====
+
+// Two labelings describe the same partition if the map from one id to
+// the other is consistent in both directions
+static bool samePartition(const int *a, const int *b, int n) {
+    int *a_to_b = (int*)malloc(n * sizeof(int));
+    int *b_to_a = (int*)malloc(n * sizeof(int));
+    bool same = true;
+    for (int i = 0; i < n; i++) a_to_b[i] = b_to_a[i] = -1;
+    for (int v = 0; v < n && same; v++) {
+        if (a_to_b[a[v]] == -1) a_to_b[a[v]] = b[v];
+        if (b_to_a[b[v]] == -1) b_to_a[b[v]] = a[v];
+        same = a_to_b[a[v]] == b[v] && b_to_a[b[v]] == a[v];
+    }
+    free(a_to_b);
+    free(b_to_a);
+    return same;
+}
+
+void benchmarkComponents(int scale, int max_threads) {
+    printf("Connected Components (R-MAT scale %d, edge factor 4):\n", scale);
+    int n = 1 << scale;
+    long long num_edges = 4LL * n;
+
+    double start = nowSeconds();
+    CSRGraph *graph = makeRMAT(scale, 4, 5);
+    printf("   Generated in %.3f s: %d vertices, %lld arcs\n",
+           nowSeconds() - start, graph->num_vertices, graph->num_arcs);
+
+    start = nowSeconds();
+    int dfs_count = csrCountComponents(graph);
+    printf("   %-26s %8.3f s  %d components\n", "DFS (explicit stack)",
+           nowSeconds() - start, dfs_count);
+
+    int uf_count;
+    start = nowSeconds();
+    int *reference = componentsUnionFind(graph, &uf_count);
+    printf("   %-26s %8.3f s  %d components\n", "Union-find on CSR",
+           nowSeconds() - start, uf_count);
+
+    // Same edges again, streamed in chunks without ever building the graph
+    enum { STREAM_CHUNK = 1 << 20 };
+    Edge *chunk = (Edge*)malloc(STREAM_CHUNK * sizeof(Edge));
+    uint64_t seed = 5;
+    start = nowSeconds();
+    UnionFind *uf = createUnionFind(n);
+    for (long long done = 0; done < num_edges; done += STREAM_CHUNK) {
+        long long count = num_edges - done < STREAM_CHUNK ? num_edges - done : STREAM_CHUNK;
+        generateRMATEdges(chunk, count, scale, &seed);
+        ufAddEdges(uf, chunk, count);
+    }
+    printf("   %-26s %8.3f s  %d components (includes generating edges)\n",
+           "Union-find, streamed", nowSeconds() - start, uf->num_components);
+    freeUnionFind(uf);
+    free(chunk);
+
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        int count;
+        start = nowSeconds();
+        int *comp = componentsAfforest(graph, threads, &count);
+        double t = nowSeconds() - start;
+        char label[64];
+        snprintf(label, sizeof(label), "Afforest (%d thr)", threads);
+        printf("   %-26s %8.3f s  %d components  %s\n", label, t, count,
+               samePartition(comp, reference, n) ? "OK" : "MISMATCH");
+        free(comp);
+    }
+    printf("\n");
+
+    free(reference);
+    csrFree(graph);
+}
+
+// ===== Loading =====
+
+static bool sameCSR(const CSRGraph *a, const CSRGraph *b) {
+    return a->num_vertices == b->num_vertices && a->num_arcs == b->num_arcs &&
+           memcmp(a->offsets, b->offsets, (a->num_vertices + 1) * sizeof(long long)) == 0 &&
+           memcmp(a->targets, b->targets, a->num_arcs * sizeof(int)) == 0 &&
+           (a->weights == NULL) == (b->weights == NULL) &&
+           (a->weights == NULL ||
+            memcmp(a->weights, b->weights, a->num_arcs * sizeof(int)) == 0);
+}
+
+void benchmarkLoading(int scale, int max_threads) {
+    printf("Graph Loading (R-MAT scale %d, edge factor 16):\n", scale);
+    int n = 1 << scale;
+    long long num_edges = 16LL * n;
+    const char *text_file = "/tmp/graph_benchmark_edges.txt";
+    const char *snapshot_file = "/tmp/graph_benchmark.csr";
+
+    Edge *edges = (Edge*)malloc(num_edges * sizeof(Edge));
+    uint64_t seed = 7;
+    generateRMATEdges(edges, num_edges, scale, &seed);
+    // Make sure the highest id appears so the loaded graph has n vertices
+    edges[num_edges - 1].src = n - 1;
+
+    double start = nowSeconds();
+    if (!writeEdgeListText(text_file, edges, num_edges, true)) {
+        free(edges);
+        return;
+    }
+    printf("   Wrote text edge list in %.3f s\n", nowSeconds() - start);
+
+    start = nowSeconds();
+    CSRGraph *reference = csrBuild(n, edges, num_edges, CSR_WEIGHTED);
+    printf("   %-28s %8.3f s\n", "csrBuild from memory", nowSeconds() - start);
+    free(edges);
+
+    for (int threads = 1; threads <= max_threads; threads *= 2) {
+        start = nowSeconds();
+        CSRGraph *loaded = loadEdgeListText(text_file, threads, CSR_WEIGHTED);
+        double t = nowSeconds() - start;
+        char label[64];
+        snprintf(label, sizeof(label), "Text load (%d thr)", threads);
+        printf("   %-28s %8.3f s %10.1f M edges/s  %s\n", label, t, num_edges / t / 1e6,
+               loaded != NULL && sameCSR(loaded, reference) ? "OK" : "MISMATCH");
+        csrFree(loaded);
+    }
+
+    start = nowSeconds();
+    bool saved = csrSaveSnapshot(reference, snapshot_file);
+    printf("   %-28s %8.3f s\n", "Save snapshot", nowSeconds() - start);
+
+    if (saved) {
+        start = nowSeconds();
+        CSRGraph *mapped = csrMapSnapshot(snapshot_file);
+        double t_map = nowSeconds() - start;
+        printf("   %-28s %8.6f s\n", "Map snapshot", t_map);
+
+        start = nowSeconds();
+        bool valid = mapped != NULL && csrValidateSnapshot(mapped);
+        printf("   %-28s %8.3f s  %s\n", "Validate snapshot (optional)", nowSeconds() - start,
+               valid ? "OK" : "INVALID");
+
+        // The first traversal pays for the page faults
+        start = nowSeconds();
+        int reached = mapped != NULL ? csrBFS(mapped, n - 1, NULL) : 0;
+        printf("   %-28s %8.3f s  %d vertices reached\n", "BFS on mapped graph",
+               nowSeconds() - start, reached);
+        printf("   Snapshot matches in-memory build: %s\n",
+               mapped != NULL && sameCSR(mapped, reference) ? "OK" : "MISMATCH");
+        csrFree(mapped);
+    }
+    printf("\n");
+
+    unlink(text_file);
+    unlink(snapshot_file);
+    csrFree(reference);
+}
+
+// ===== Whole suite =====
+
+// Peak resident set size of the process so far, in MB
+static double peakRSSMegabytes(void) {
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    return usage.ru_maxrss / 1024.0;   // ru_maxrss is in KB on Linux
+}
+
+typedef struct {
+    const char *name;
+    CSRGraph* (*make)(int scale, uint64_t seed);
+} GraphFamily;
+
+static CSRGraph* makeKroneckerFamily(int scale, uint64_t seed) { return makeKronecker(scale, 16, seed); }
+static CSRGraph* makeUniformFamily(int scale, uint64_t seed) { return makeUniform(scale, 16, seed); }
+static CSRGraph* makeGrid2DFamily(int scale, uint64_t seed) { return makeGrid2D(1 << (scale / 2), seed); }
+
+static CSRGraph* makeGrid3DFamily(int scale, uint64_t seed) {
+    int side = 1;
+    while ((long long)(side + 1) * (side + 1) * (side + 1) <= (1LL << scale)) side++;
+    return makeGrid3D(side, seed);
+}
+
+// TEPS counts undirected edges in the searched component, as Graph500 does
+void benchmarkSuite(int scale, int max_threads) {
+    static const GraphFamily families[] = {
+        { "Kronecker", makeKroneckerFamily },
+        { "Uniform", makeUniformFamily },
+        { "Grid 2D", makeGrid2DFamily },
+        { "Grid 3D", makeGrid3DFamily },
+    };
+    int num_families = (int)(sizeof(families) / sizeof(families[0]));
+
+    printf("Benchmark Suite (scale %d, %d threads):\n", scale, max_threads);
+    printf("   %-10s %10s %11s %8s %10s %10s %10s %9s\n", "Graph", "Vertices", "Edges",
+           "Build s", "BFS MTEPS", "CC MEdge/s", "SSSP MTEPS", "Peak MB");
+
+    for (int f = 0; f < num_families; f++) {
+        double start = nowSeconds();
+        CSRGraph *graph = families[f].make(scale, 11 + f);
+        double t_build = nowSeconds() - start;
+        int n = graph->num_vertices;
+        long long edges = graph->num_arcs / 2;
+
+        // Source with at least one edge, the same for BFS and SSSP
+        uint64_t seed = 42;
+        int source = pickNonIsolated(graph, &seed);
+        if (source < 0) {
+            printf("   %-10s %10d %11lld %8.3f   (no edges, skipped)\n", families[f].name,
+                   n, edges, t_build);
+            csrFree(graph);
+            continue;
+        }
+
+        int *parent = (int*)malloc(n * sizeof(int));
+        BFSStats stats;
+        start = nowSeconds();
+        parallelBFS(graph, source, max_threads, parent, &stats);
+        double t_bfs = nowSeconds() - start;
+        free(parent);
+
+        start = nowSeconds();
+        free(componentsAfforest(graph, max_threads, NULL));
+        double t_cc = nowSeconds() - start;
+
+        start = nowSeconds();
+        freeSSSPResult(deltaStepping(graph, source, 100, max_threads));
+        double t_sssp = nowSeconds() - start;
+
+        printf("   %-10s %10d %11lld %8.3f %10.1f %10.1f %10.1f %9.1f\n", families[f].name,
+               n, edges, t_build, stats.edges_in_component / 2 / t_bfs / 1e6,
+               edges / t_cc / 1e6, stats.edges_in_component / 2 / t_sssp / 1e6,
+               peakRSSMegabytes());
+        csrFree(graph);
+    }
+    printf("\n");
+}
+
+int main(int argc, char *argv[]) {
+    printf("=== Graph Benchmarks ===\n\n");
+
+    const char *which = argc > 1 ? argv[1] : "sssp";
+    int scale = argc > 2 ? atoi(argv[2]) : 20;
+    int max_threads = argc > 3 ? atoi(argv[3]) : 4;
+    if (max_threads < 1) max_threads = 1;
+    if (scale < 1 || scale > GEN_MAX_SCALE) {
+        printf("Scale must be between 1 and %d\n", GEN_MAX_SCALE);
+        return 1;
+    }
+
+    if (strcmp(which, "all") == 0) {
+        benchmarkSuite(scale, max_threads);
+    } else if (strcmp(which, "sssp") == 0) {
+        benchmarkSSSP(scale, max_threads);
+    } else if (strcmp(which, "p2p") == 0) {
+        benchmarkPointToPoint(scale);
+    } else if (strcmp(which, "mst") == 0) {
+        benchmarkMST(scale, max_threads);
+    } else if (strcmp(which, "dag") == 0) {
+        benchmarkDirected(scale, max_threads);
+    } else if (strcmp(which, "triangles") == 0) {
+        benchmarkTriangles(scale, max_threads);
+    } else if (strcmp(which, "bfs") == 0) {
+        benchmarkBFS(scale, max_threads);
+    } else if (strcmp(which, "msbfs") == 0) {
+        benchmarkMultiSourceBFS(scale, 4 * MSBFS_BATCH);
+    } else if (strcmp(which, "cc") == 0) {
+        benchmarkComponents(scale, max_threads);
+    } else if (strcmp(which, "dynamic") == 0) {
+        benchmarkDynamic(scale, 100);
+    } else if (strcmp(which, "pagerank") == 0) {
+        benchmarkPageRank(scale, max_threads);
+    } else if (strcmp(which, "io") == 0) {
+        benchmarkLoading(scale, max_threads);
+    } else {
+        printf("Unknown benchmark '%s'\n", which);
+        printf("Usage: ./graph_benchmark [all|sssp|p2p|mst|dag|triangles|bfs|msbfs|cc|dynamic|pagerank|io] [scale] [max_threads]\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,136 @@
+/*
+ * graph_generators.c
+ * Seeded R-MAT, Kronecker, grid and uniform random graphs
+ * Topics: recursive matrix sampling, Fisher-Yates relabeling, meshes
+ */
+
+#include <stdlib.h>
+#include <limits.h>
+#include "graph_generators.h"
+
+static inline int randomWeight(uint64_t *seed) {
+    return (int)(genRandom(seed) % GEN_MAX_WEIGHT) + 1;
+}
+
+// The all-zero xorshift state never changes; map seed 0 to 1
+static inline uint64_t seedState(uint64_t seed) {
+    return seed != 0 ? seed : 1;
+}
+
+// R-MAT edges: recursively pick a quadrant of the adjacency matrix
+// with probabilities a=0.57, b=0.19, c=0.19, d=0.05
+void generateRMATEdges(Edge *edges, long long count, int scale, uint64_t *seed) {
+    for (long long e = 0; e < count; e++) {
+        int src = 0, dest = 0;
+        for (int bit = 0; bit < scale; bit++) {
+            double p = (genRandom(seed) >> 11) * (1.0 / 9007199254740992.0);
+            if (p >= 0.57 && p < 0.76) {
+                dest |= 1 << bit;
+            } else if (p >= 0.76 && p < 0.95) {
+                src |= 1 << bit;
+            } else if (p >= 0.95) {
+                src |= 1 << bit;
+                dest |= 1 << bit;
+            }
+        }
+        edges[e] = (Edge){ src, dest, randomWeight(seed) };
+    }
+}
+
+CSRGraph* makeRMAT(int scale, int edge_factor, uint64_t seed) {
+    if (scale < 1 || scale > GEN_MAX_SCALE) return NULL;
+    int n = 1 << scale;
+    long long num_edges = (long long)edge_factor * n;
+    uint64_t state = seedState(seed);
+    Edge *edges = (Edge*)malloc((num_edges > 0 ? num_edges : 1) * sizeof(Edge));
+    generateRMATEdges(edges, num_edges, scale, &state);
+    CSRGraph *graph = csrBuild(n, edges, num_edges, CSR_WEIGHTED);
+    free(edges);
+    return graph;
+}
+
+CSRGraph* makeKronecker(int scale, int edge_factor, uint64_t seed) {
+    if (scale < 1 || scale > GEN_MAX_SCALE) return NULL;
+    int n = 1 << scale;
+    long long num_edges = (long long)edge_factor * n;
+    uint64_t state = seedState(seed);
+    Edge *edges = (Edge*)malloc((num_edges > 0 ? num_edges : 1) * sizeof(Edge));
+    generateRMATEdges(edges, num_edges, scale, &state);
+
+    // Fisher-Yates shuffle of the vertex ids
+    int *label = (int*)malloc(n * sizeof(int));
+    for (int v = 0; v < n; v++) label[v] = v;
+    for (int v = n - 1; v > 0; v--) {
+        int j = (int)(genRandom(&state) % (uint64_t)(v + 1));
+        int tmp = label[v];
+        label[v] = label[j];
+        label[j] = tmp;
+    }
+    for (long long e = 0; e < num_edges; e++) {
+        edges[e].src = label[edges[e].src];
+        edges[e].dest = label[edges[e].dest];
+    }
+    free(label);
+
+    CSRGraph *graph = csrBuild(n, edges, num_edges, CSR_WEIGHTED);
+    free(edges);
+    return graph;
+}
+
+CSRGraph* makeGrid2D(int side, uint64_t seed) {
+    long long n = (long long)side * side;
+    if (side < 1 || n > INT_MAX) return NULL;
+    long long num_edges = 2LL * side * (side - 1);
+    uint64_t state = seedState(seed);
+    Edge *edges = (Edge*)malloc((num_edges > 0 ? num_edges : 1) * sizeof(Edge));
+    long long k = 0;
+    for (int r = 0; r < side; r++) {
+        for (int c = 0; c < side; c++) {
+            int v = r * side + c;
+            if (c + 1 < side) edges[k++] = (Edge){ v, v + 1, randomWeight(&state) };
+            if (r + 1 < side) edges[k++] = (Edge){ v, v + side, randomWeight(&state) };
+        }
+    }
+    CSRGraph *graph = csrBuild((int)n, edges, k, CSR_WEIGHTED);
+    free(edges);
+    return graph;
+}
+
+CSRGraph* makeGrid3D(int side, uint64_t seed) {
+    long long n = (long long)side * side * side;
+    if (side < 1 || n > INT_MAX) return NULL;
+    long long num_edges = 3LL * side * side * (side - 1);
+    uint64_t state = seedState(seed);
+    Edge *edges = (Edge*)malloc((num_edges > 0 ? num_edges : 1) * sizeof(Edge));
+    int plane = side * side;
+    long long k = 0;
+    for (int z = 0; z < side; z++) {
+        for (int y = 0; y < side; y++) {
+            for (int x = 0; x < side; x++) {
+                int v = z * plane + y * side + x;
+                if (x + 1 < side) edges[k++] = (Edge){ v, v + 1, randomWeight(&state) };
+                if (y + 1 < side) edges[k++] = (Edge){ v, v + side, randomWeight(&state) };
+                if (z + 1 < side) edges[k++] = (Edge){ v, v + plane, randomWeight(&state) };
+            }
+        }
+    }
+    CSRGraph *graph = csrBuild((int)n, edges, k, CSR_WEIGHTED);
+    free(edges);
+    return graph;
+}
+
+CSRGraph* makeUniform(int scale, int edge_factor, uint64_t seed) {
+    if (scale < 1 || scale > GEN_MAX_SCALE) return NULL;
+    int n = 1 << scale;
+    long long num_edges = (long long)edge_factor * n;
+    uint64_t state = seedState(seed);
+    Edge *edges = (Edge*)malloc((num_edges > 0 ? num_edges : 1) * sizeof(Edge));
+    for (long long e = 0; e < num_edges; e++) {
+        int src = (int)(genRandom(&state) % (uint64_t)n);
+        int dest = (int)(genRandom(&state) % (uint64_t)n);
+        edges[e] = (Edge){ src, dest, randomWeight(&state) };
+    }
+    CSRGraph *graph = csrBuild(n, edges, num_edges, CSR_WEIGHTED);
+    free(edges);
+    return graph;
+}
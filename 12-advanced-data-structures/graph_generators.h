@@ -0,0 +1,75 @@
+/*
+ * graph_generators.h
+ * Reproducible synthetic graphs for testing and benchmarking
+ *
+ * Every generator is a pure function of its size parameters and seed,
+ * so two runs (or two machines) build identical graphs. Edges carry
+ * weights in 1..100 and are stored with CSR_WEIGHTED; grids are meshes
+ * like road networks, R-MAT/Kronecker graphs have power-law degrees
+ * like social and web graphs, and uniform graphs have Poisson degrees.
+ */
+
+#ifndef GRAPH_GENERATORS_H
+#define GRAPH_GENERATORS_H
+
+#include <stdint.h>
+#include "csr_graph.h"
+
+#define GEN_MAX_WEIGHT 100
+#define GEN_MAX_SCALE 30            // 2^scale vertices must fit in an int
+
+/**
+ * @brief xorshift64 step shared by the generators
+ * @param state Non-zero generator state, updated in place
+ */
+static inline uint64_t genRandom(uint64_t *state) {
+    uint64_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 7;
+    x ^= x << 17;
+    *state = x;
+    return x;
+}
+
+/**
+ * @brief Fill edges with R-MAT edges over 2^scale vertices
+ * @param seed Generator state, advanced so the next call continues the
+ *             same stream (lets callers generate edges in chunks)
+ *
+ * Quadrant probabilities are the Graph500 ones: a=0.57, b=c=0.19, d=0.05.
+ */
+void generateRMATEdges(Edge *edges, long long count, int scale, uint64_t *seed);
+
+/**
+ * @brief R-MAT graph: 2^scale vertices, edge_factor * 2^scale edges
+ *
+ * High-degree vertices cluster at small ids. Like every generator
+ * taking a scale, returns NULL unless 1 <= scale <= GEN_MAX_SCALE.
+ */
+CSRGraph* makeRMAT(int scale, int edge_factor, uint64_t seed);
+
+/**
+ * @brief Graph500-style Kronecker graph: R-MAT with vertex ids
+ *        randomly permuted, so degree does not correlate with id
+ */
+CSRGraph* makeKronecker(int scale, int edge_factor, uint64_t seed);
+
+/**
+ * @brief side x side 4-neighbor grid
+ * @return NULL unless side >= 1 and side^2 fits in an int
+ */
+CSRGraph* makeGrid2D(int side, uint64_t seed);
+
+/**
+ * @brief side x side x side 6-neighbor grid
+ * @return NULL unless side >= 1 and side^3 fits in an int
+ */
+CSRGraph* makeGrid3D(int side, uint64_t seed);
+
+/**
+ * @brief Uniform random graph: edge_factor * 2^scale edges with both
+ *        endpoints drawn uniformly from 2^scale vertices
+ */
+CSRGraph* makeUniform(int scale, int edge_factor, uint64_t seed);
+
+#endif /* GRAPH_GENERATORS_H */
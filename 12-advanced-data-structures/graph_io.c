@@ -0,0 +1,330 @@
+/*
+ * graph_io.c
+ * Parallel text edge-list loader and mmap'd binary CSR snapshots
+ * Topics: mmap, splitting input at line boundaries, hand-written
+ *         integer parsing, zero-copy loading
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "graph_io.h"
+
+bool writeEdgeListText(const char *filename, const Edge *edges, long long num_edges,
+                       bool with_weights) {
+    FILE *fp = fopen(filename, "w");
+    if (fp == NULL) {
+        perror("Error opening edge list for writing");
+        return false;
+    }
+
+    fprintf(fp, "# src dest%s\n", with_weights ? " weight" : "");
+    for (long long e = 0; e < num_edges; e++) {
+        if (with_weights) {
+            fprintf(fp, "%d %d %d\n", edges[e].src, edges[e].dest, edges[e].weight);
+        } else {
+            fprintf(fp, "%d %d\n", edges[e].src, edges[e].dest);
+        }
+    }
+
+    if (fclose(fp) != 0) {
+        perror("Error writing edge list");
+        return false;
+    }
+    return true;
+}
+
+// ===== Parallel text parsing =====
+
+typedef struct {
+    const char *begin;
+    const char *end;
+    Edge *edges;
+    long long count;
+    long long capacity;
+    int max_vertex;
+    long long error_line;   // 0 if the chunk parsed cleanly
+} ParseChunk;
+
+static inline const char* skipBlanks(const char *p, const char *end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\r' || *p == ',')) p++;
+    return p;
+}
+
+// Parse a decimal integer; the mapping is not NUL-terminated, so the
+// parser must stop at end. Returns NULL if no digits were found, if the
+// number does not end at a blank or newline, or if it overflows.
+static const char* parseInt(const char *p, const char *end, long long *value) {
+    bool negative = false;
+    if (p < end && *p == '-') {
+        negative = true;
+        p++;
+    }
+    if (p == end || *p < '0' || *p > '9') return NULL;
+
+    long long v = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        int digit = *p - '0';
+        if (v > (LLONG_MAX - digit) / 10) return NULL;
+        v = v * 10 + digit;
+        p++;
+    }
+    if (p < end && *p != '\n' && skipBlanks(p, end) == p) return NULL;
+    *value = negative ? -v : v;
+    return p;
+}
+
+static void* parseChunkWorker(void *arg) {
+    ParseChunk *chunk = (ParseChunk*)arg;
+    const char *p = chunk->begin;
+    const char *end = chunk->end;
+    long long line = 0;
+
+    while (p < end) {
+        line++;
+        p = skipBlanks(p, end);
+        if (p == end) break;
+        if (*p == '\n' || *p == '#' || *p == '%') {
+            while (p < end && *p != '\n') p++;
+            p++;
+            continue;
+        }
+
+        long long src, dest, weight = 1;
+        p = parseInt(p, end, &src);
+        if (p != NULL) p = parseInt(skipBlanks(p, end), end, &dest);
+        if (p == NULL || src < 0 || dest < 0 || src > INT_MAX - 1 || dest > INT_MAX - 1) {
+            chunk->error_line = line;
+            return NULL;
+        }
+        // Optional weight, then nothing but blanks up to the newline
+        p = skipBlanks(p, end);
+        if (p < end && *p != '\n') {
+            p = parseInt(p, end, &weight);
+            if (p == NULL || weight < INT_MIN || weight > INT_MAX) {
+                chunk->error_line = line;
+                return NULL;
+            }
+            p = skipBlanks(p, end);
+            if (p < end && *p != '\n') {
+                chunk->error_line = line;
+                return NULL;
+            }
+        }
+        p++;
+
+        if (chunk->count == chunk->capacity) {
+            chunk->capacity = chunk->capacity ? chunk->capacity * 2 : 4096;
+            chunk->edges = (Edge*)realloc(chunk->edges, chunk->capacity * sizeof(Edge));
+        }
+        chunk->edges[chunk->count++] = (Edge){ (int)src, (int)dest, (int)weight };
+        if (src > chunk->max_vertex) chunk->max_vertex = (int)src;
+        if (dest > chunk->max_vertex) chunk->max_vertex = (int)dest;
+    }
+    return NULL;
+}
+
+CSRGraph* loadEdgeListText(const char *filename, int num_threads, int flags) {
+    if (num_threads < 1) num_threads = 1;
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        perror("Error opening edge list");
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        perror("Error reading edge list size");
+        close(fd);
+        return NULL;
+    }
+    size_t size = (size_t)st.st_size;
+    if (size == 0) {
+        close(fd);
+        return csrBuild(0, NULL, 0, flags);
+    }
+
+    const char *data = (const char*)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) {
+        perror("Error mapping edge list");
+        return NULL;
+    }
+    posix_madvise((void*)data, size, POSIX_MADV_SEQUENTIAL);
+
+    // Split into equal byte ranges, then move each cut past the next newline
+    ParseChunk *chunks = (ParseChunk*)calloc(num_threads, sizeof(ParseChunk));
+    const char *file_end = data + size;
+    for (int t = 0; t < num_threads; t++) {
+        const char *cut = data + size * t / num_threads;
+        if (t > 0) {
+            while (cut < file_end && cut[-1] != '\n') cut++;
+        }
+        chunks[t].begin = cut;
+        chunks[t].max_vertex = -1;
+        if (t > 0) chunks[t - 1].end = cut;
+    }
+    chunks[num_threads - 1].end = file_end;
+
+    pthread_t *threads = (pthread_t*)malloc(num_threads * sizeof(pthread_t));
+    for (int t = 1; t < num_threads; t++) {
+        pthread_create(&threads[t], NULL, parseChunkWorker, &chunks[t]);
+    }
+    parseChunkWorker(&chunks[0]);
+    for (int t = 1; t < num_threads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    free(threads);
+
+    // Concatenate in chunk order so the edge order matches the file. Only
+    // the first bad line is reported; chunk line numbers are made absolute
+    // by counting the newlines before the chunk.
+    long long total = 0;
+    int max_vertex = -1;
+    bool ok = true;
+    for (int t = 0; t < num_threads; t++) {
+        if (ok && chunks[t].error_line != 0) {
+            long long line = chunks[t].error_line;
+            for (const char *q = data; (q = memchr(q, '\n', (size_t)(chunks[t].begin - q)));
+                 q++) {
+                line++;
+            }
+            fprintf(stderr, "Error parsing %s: bad line %lld\n", filename, line);
+            ok = false;
+        }
+        total += chunks[t].count;
+        if (chunks[t].max_vertex > max_vertex) max_vertex = chunks[t].max_vertex;
+    }
+    munmap((void*)data, size);
+
+    CSRGraph *graph = NULL;
+    if (ok) {
+        Edge *edges = (Edge*)malloc((total > 0 ? total : 1) * sizeof(Edge));
+        long long offset = 0;
+        for (int t = 0; t < num_threads; t++) {
+            if (chunks[t].count > 0) {
+                memcpy(edges + offset, chunks[t].edges, chunks[t].count * sizeof(Edge));
+            }
+            offset += chunks[t].count;
+            free(chunks[t].edges);
+            chunks[t].edges = NULL;
+        }
+        graph = csrBuild(max_vertex + 1, edges, total, flags);
+        free(edges);
+    }
+
+    for (int t = 0; t < num_threads; t++) free(chunks[t].edges);
+    free(chunks);
+    return graph;
+}
+
+// ===== Binary snapshots =====
+
+bool csrSaveSnapshot(const CSRGraph *graph, const char *filename) {
+    FILE *fp = fopen(filename, "wb");
+    if (fp == NULL) {
+        perror("Error opening snapshot for writing");
+        return false;
+    }
+
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.byte_order = SNAPSHOT_BYTE_ORDER;
+    header.flags = (graph->directed ? CSR_DIRECTED : 0) |
+                   (graph->weights != NULL ? CSR_WEIGHTED : 0);
+    header.num_vertices = graph->num_vertices;
+    header.num_arcs = graph->num_arcs;
+
+    size_t n = (size_t)graph->num_vertices;
+    size_t m = (size_t)graph->num_arcs;
+    bool ok = fwrite(&header, sizeof(header), 1, fp) == 1 &&
+              fwrite(graph->offsets, sizeof(long long), n + 1, fp) == n + 1 &&
+              fwrite(graph->targets, sizeof(int), m, fp) == m &&
+              (graph->weights == NULL ||
+               fwrite(graph->weights, sizeof(int), m, fp) == m);
+
+    if (fclose(fp) != 0) ok = false;
+    if (!ok) perror("Error writing snapshot");
+    return ok;
+}
+
+// One pass over the arrays that follow a header whose sizes fit the
+// file: offsets run from 0 to num_arcs without decreasing, and every
+// target is a vertex
+CSRGraph* csrMapSnapshot(const char *filename) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        perror("Error opening snapshot");
+        return NULL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(SnapshotHeader)) {
+        fprintf(stderr, "Error: %s is too small to be a snapshot\n", filename);
+        close(fd);
+        return NULL;
+    }
+
+    size_t size = (size_t)st.st_size;
+    char *base = (char*)mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        perror("Error mapping snapshot");
+        return NULL;
+    }
+
+    // Sizes are checked by division so that no header value can make the
+    // expected size wrap around
+    const SnapshotHeader *header = (const SnapshotHeader*)base;
+    bool valid = memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) == 0 &&
+                 header->version == SNAPSHOT_VERSION &&
+                 header->byte_order == SNAPSHOT_BYTE_ORDER &&
+                 header->num_vertices >= 0 && header->num_vertices < INT_MAX &&
+                 header->num_arcs >= 0;
+    bool weighted = (header->flags & CSR_WEIGHTED) != 0;
+    if (valid) {
+        size_t payload = size - sizeof(SnapshotHeader);
+        size_t offsets_bytes = ((size_t)header->num_vertices + 1) * sizeof(long long);
+        size_t arc_bytes = sizeof(int) * (weighted ? 2 : 1);
+        valid = offsets_bytes <= payload &&
+                (uint64_t)header->num_arcs <= (payload - offsets_bytes) / arc_bytes;
+    }
+    if (!valid) {
+        fprintf(stderr, "Error: %s is not a valid CSR snapshot\n", filename);
+        munmap(base, size);
+        return NULL;
+    }
+
+    CSRGraph *graph = (CSRGraph*)malloc(sizeof(CSRGraph));
+    graph->num_vertices = (int)header->num_vertices;
+    graph->num_arcs = header->num_arcs;
+    graph->directed = (header->flags & CSR_DIRECTED) != 0;
+    graph->offsets = (long long*)(base + sizeof(SnapshotHeader));
+    graph->targets = (int*)(graph->offsets + graph->num_vertices + 1);
+    graph->weights = weighted ? graph->targets + graph->num_arcs : NULL;
+    graph->mapped_base = base;
+    graph->mapped_size = (long long)size;
+    return graph;
+}
+
+bool csrValidateSnapshot(const CSRGraph *graph) {
+    long long n = graph->num_vertices;
+    long long m = graph->num_arcs;
+    if (graph->offsets[0] != 0 || graph->offsets[n] != m) return false;
+    for (long long v = 0; v < n; v++) {
+        if (graph->offsets[v + 1] < graph->offsets[v]) return false;
+    }
+    for (long long e = 0; e < m; e++) {
+        if (graph->targets[e] < 0 || graph->targets[e] >= n) return false;
+    }
+    return true;
+}
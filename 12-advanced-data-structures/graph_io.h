@@ -0,0 +1,79 @@
+/*
+ * graph_io.h
+ * Loading and saving CSR graphs
+ *
+ * Text edge lists: one "src dest [weight]" per line, '#' or '%' starts
+ * a comment line. Any other text on a line, or a number outside int
+ * range, is an error reported with its line number. The file is mmap'd
+ * and split into newline-aligned chunks that worker threads parse in
+ * parallel.
+ *
+ * Binary snapshots: a fixed header followed by the raw offsets,
+ * targets and (optional) weights arrays. A snapshot is mmap'd and used
+ * in place, so reloading costs a few header checks instead of a full
+ * parse and a copy; csrValidateSnapshot() checks the arrays themselves
+ * when the file may not have come from csrSaveSnapshot(). Snapshots use
+ * the byte order of the machine that wrote them; loading on a different
+ * byte order is rejected.
+ */
+
+#ifndef GRAPH_IO_H
+#define GRAPH_IO_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "csr_graph.h"
+
+#define SNAPSHOT_MAGIC "CSRGRAPH"
+#define SNAPSHOT_VERSION 1
+#define SNAPSHOT_BYTE_ORDER 0x01020304u
+
+typedef struct {
+    char magic[8];              // SNAPSHOT_MAGIC, not NUL-terminated
+    uint32_t version;
+    uint32_t byte_order;        // SNAPSHOT_BYTE_ORDER as written
+    uint32_t flags;             // CSR_DIRECTED / CSR_WEIGHTED
+    uint32_t reserved;
+    int64_t num_vertices;
+    int64_t num_arcs;
+} SnapshotHeader;               // 40 bytes; offsets[] follow, 8-byte aligned
+
+/**
+ * @brief Write edges as a text edge list
+ * @return false (with perror) on I/O failure
+ */
+bool writeEdgeListText(const char *filename, const Edge *edges, long long num_edges,
+                       bool with_weights);
+
+/**
+ * @brief Parse a text edge list with num_threads threads and build CSR
+ * @param flags CSR_DIRECTED / CSR_WEIGHTED, as for csrBuild
+ * @return New graph with max vertex id + 1 vertices, or NULL on error
+ */
+CSRGraph* loadEdgeListText(const char *filename, int num_threads, int flags);
+
+/**
+ * @brief Save a graph as a binary snapshot
+ * @return false (with perror) on I/O failure
+ */
+bool csrSaveSnapshot(const CSRGraph *graph, const char *filename);
+
+/**
+ * @brief Map a snapshot and use its arrays in place (no parsing)
+ * Only the header and the file size are checked (O(1)); call
+ * csrValidateSnapshot() before using a file you did not save yourself.
+ * @return Graph whose arrays point into the mapping (release with
+ *         csrFree), or NULL if the file is missing or malformed. The
+ *         mapping is read-only: save a graph after csrSortNeighbors()
+ *         rather than sorting a mapped one.
+ */
+CSRGraph* csrMapSnapshot(const char *filename);
+
+/**
+ * @brief Check a mapped graph's arrays in one O(n + m) pass
+ * @return true if offsets run from 0 to num_arcs without decreasing and
+ *         every target is a vertex id
+ */
+bool csrValidateSnapshot(const CSRGraph *graph);
+
+#endif /* GRAPH_IO_H */
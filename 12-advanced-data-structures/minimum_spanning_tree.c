@@ -0,0 +1,307 @@
+/*
+ * minimum_spanning_tree.c
+ * Kruskal (parallel sort + union-find) and parallel Boruvka
+ * Topics: parallel merge sort of an edge list, lock-free minimum with
+ *         CAS on packed keys, pointer jumping
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include "minimum_spanning_tree.h"
+#include "connected_components.h"
+#include "parallel_for.h"
+
+#define MST_CHUNK 4096
+
+// ===== Shared helpers =====
+
+// Each undirected edge once (self loops can never be in a tree)
+static Edge* extractEdges(const CSRGraph *graph, long long *num_edges) {
+    Edge *edges = (Edge*)malloc((graph->num_arcs > 0 ? graph->num_arcs : 1) * sizeof(Edge));
+    long long k = 0;
+    for (int u = 0; u < graph->num_vertices; u++) {
+        for (long long i = graph->offsets[u]; i < graph->offsets[u + 1]; i++) {
+            int v = graph->targets[i];
+            if (u == v || (!graph->directed && v < u)) continue;
+            edges[k++] = (Edge){ u, v, graph->weights != NULL ? graph->weights[i] : 1 };
+        }
+    }
+    *num_edges = k;
+    return edges;
+}
+
+static MSTResult* createMSTResult(int num_vertices) {
+    MSTResult *result = (MSTResult*)malloc(sizeof(MSTResult));
+    result->edges = (Edge*)malloc((num_vertices > 0 ? num_vertices : 1) * sizeof(Edge));
+    result->num_edges = 0;
+    result->total_weight = 0;
+    return result;
+}
+
+void freeMSTResult(MSTResult *result) {
+    if (result == NULL) return;
+    free(result->edges);
+    free(result);
+}
+
+// ===== Kruskal =====
+
+static int compareEdges(const void *a, const void *b) {
+    const Edge *x = (const Edge*)a;
+    const Edge *y = (const Edge*)b;
+    if (x->weight != y->weight) return x->weight < y->weight ? -1 : 1;
+    if (x->src != y->src) return x->src < y->src ? -1 : 1;
+    return (x->dest > y->dest) - (x->dest < y->dest);
+}
+
+typedef struct {
+    Edge *from;
+    Edge *to;
+    long long count;
+    long long run;          // Length of the sorted runs being merged
+    long long slices;       // Output slices per merge round
+} SortPass;
+
+static void sortRuns(void *context, long long begin, long long end, int thread) {
+    (void)thread;
+    SortPass *pass = (SortPass*)context;
+    for (long long r = begin; r < end; r++) {
+        long long lo = r * pass->run;
+        long long hi = lo + pass->run < pass->count ? lo + pass->run : pass->count;
+        qsort(pass->from + lo, hi - lo, sizeof(Edge), compareEdges);
+    }
+}
+
+// Number of edges taken from a among the first k outputs of a stable
+// merge of a and b (ties come from a first)
+static long long coRankEdges(long long k, const Edge *a, long long len_a, const Edge *b,
+                             long long len_b) {
+    long long lo = k > len_b ? k - len_b : 0;
+    long long hi = k < len_a ? k : len_a;
+    while (lo < hi) {
+        long long i = lo + (hi - lo) / 2;
+        if (compareEdges(&b[k - i - 1], &a[i]) < 0) hi = i; else lo = i + 1;
+    }
+    return lo;
+}
+
+static void mergeEdgeRange(const Edge *a, long long len_a, const Edge *b, long long len_b,
+                           Edge *out) {
+    long long i = 0, j = 0, k = 0;
+    while (i < len_a && j < len_b) {
+        out[k++] = compareEdges(&b[j], &a[i]) < 0 ? b[j++] : a[i++];
+    }
+    while (i < len_a) out[k++] = a[i++];
+    while (j < len_b) out[k++] = b[j++];
+}
+
+// Write output slices [begin, end) of a round that merges runs 2p and
+// 2p + 1 of from into to. Slices split the output evenly, so the last
+// rounds (one or two large pairs) still use every thread.
+static void mergeSlices(void *context, long long begin, long long end, int thread) {
+    (void)thread;
+    SortPass *pass = (SortPass*)context;
+    long long count = pass->count, run = pass->run;
+    for (long long slice = begin; slice < end; slice++) {
+        long long out_begin = count * slice / pass->slices;
+        long long out_end = count * (slice + 1) / pass->slices;
+        for (long long pair_begin = out_begin / (2 * run) * (2 * run); pair_begin < out_end;
+             pair_begin += 2 * run) {
+            long long mid = pair_begin + run < count ? pair_begin + run : count;
+            long long pair_end = mid + run < count ? mid + run : count;
+
+            // This slice's part of the pair's output, in pair-relative ranks
+            long long lo = (out_begin > pair_begin ? out_begin : pair_begin) - pair_begin;
+            long long hi = (out_end < pair_end ? out_end : pair_end) - pair_begin;
+            const Edge *a = pass->from + pair_begin;
+            const Edge *b = pass->from + mid;
+            long long len_a = mid - pair_begin, len_b = pair_end - mid;
+            long long i_lo = coRankEdges(lo, a, len_a, b, len_b);
+            long long i_hi = coRankEdges(hi, a, len_a, b, len_b);
+            mergeEdgeRange(a + i_lo, i_hi - i_lo, b + (lo - i_lo), (hi - i_hi) - (lo - i_lo),
+                           pass->to + pair_begin + lo);
+        }
+    }
+}
+
+// Sort num_threads runs in parallel, then merge pairs of runs until one
+// run is left, every round split across threads by co-rank. Returns the
+// buffer holding the result.
+static Edge* parallelSortEdges(Edge *edges, Edge *buffer, long long count, int num_threads) {
+    SortPass pass = { edges, buffer, count, (count + num_threads - 1) / num_threads,
+                      num_threads };
+    if (pass.run < 1) pass.run = 1;
+    long long runs = (count + pass.run - 1) / pass.run;
+    parallelFor(runs, 1, num_threads, sortRuns, &pass);
+
+    while (pass.run < count) {
+        parallelFor(pass.slices, 1, num_threads, mergeSlices, &pass);
+        Edge *tmp = pass.from;
+        pass.from = pass.to;
+        pass.to = tmp;
+        pass.run *= 2;
+    }
+    return pass.from;
+}
+
+MSTResult* mstKruskal(const CSRGraph *graph, int num_threads) {
+    int n = graph->num_vertices;
+    if (num_threads < 1) num_threads = 1;
+
+    long long num_edges;
+    Edge *edges = extractEdges(graph, &num_edges);
+    Edge *buffer = (Edge*)malloc((num_edges > 0 ? num_edges : 1) * sizeof(Edge));
+    Edge *sorted = parallelSortEdges(edges, buffer, num_edges, num_threads);
+
+    MSTResult *result = createMSTResult(n);
+    UnionFind *uf = createUnionFind(n);
+    for (long long e = 0; e < num_edges && uf->num_components > 1; e++) {
+        if (ufUnion(uf, sorted[e].src, sorted[e].dest)) {
+            result->edges[result->num_edges++] = sorted[e];
+            result->total_weight += sorted[e].weight;
+        }
+    }
+
+    freeUnionFind(uf);
+    free(edges);
+    free(buffer);
+    return result;
+}
+
+// ===== Boruvka =====
+// comp[v] is flat (points straight at the root) at the start of every
+// round. Keys pack weight above the edge index, so the atomic minimum
+// is unique per edge and every component agrees on the order of ties.
+
+#define NO_EDGE UINT64_MAX
+#define KEY_INDEX_BITS 33           // Edge index below, weight above
+#define KEY_INDEX_MASK ((1ULL << KEY_INDEX_BITS) - 1)
+
+typedef struct {
+    Edge *edges;
+    long long num_edges;
+    _Atomic int *comp;
+    _Atomic uint64_t *best;         // Per component root: lightest key
+    int *next;                      // Per root: parent chosen this round
+    MSTResult *result;
+    atomic_llong result_size;
+    atomic_llong total_weight;
+} BoruvkaState;
+
+static inline uint64_t edgeKey(const Edge *edge, long long index) {
+    return ((uint64_t)(unsigned)edge->weight << KEY_INDEX_BITS) | (uint64_t)index;
+}
+
+static inline void atomicMinKey(_Atomic uint64_t *slot, uint64_t key) {
+    uint64_t old = atomic_load_explicit(slot, memory_order_relaxed);
+    while (key < old &&
+           !atomic_compare_exchange_weak_explicit(slot, &old, key, memory_order_relaxed,
+                                                  memory_order_relaxed)) {
+    }
+}
+
+static void findLightestEdges(void *context, long long begin, long long end, int thread) {
+    (void)thread;
+    BoruvkaState *s = (BoruvkaState*)context;
+    for (long long e = begin; e < end; e++) {
+        int cu = atomic_load_explicit(&s->comp[s->edges[e].src], memory_order_relaxed);
+        int cv = atomic_load_explicit(&s->comp[s->edges[e].dest], memory_order_relaxed);
+        if (cu == cv) continue;
+        uint64_t key = edgeKey(&s->edges[e], e);
+        atomicMinKey(&s->best[cu], key);
+        atomicMinKey(&s->best[cv], key);
+    }
+}
+
+// Every root with an outgoing edge picks its parent along its lightest
+// edge. Two roots that picked the same edge form the only possible
+// cycle; the smaller one stays a root and the other records the edge.
+static void chooseParents(void *context, long long begin, long long end, int thread) {
+    (void)thread;
+    BoruvkaState *s = (BoruvkaState*)context;
+    for (long long c = begin; c < end; c++) {
+        s->next[c] = (int)c;
+        uint64_t key = atomic_load_explicit(&s->best[c], memory_order_relaxed);
+        if (key == NO_EDGE) continue;
+
+        const Edge *edge = &s->edges[key & KEY_INDEX_MASK];
+        int cu = atomic_load_explicit(&s->comp[edge->src], memory_order_relaxed);
+        int other = cu == (int)c ? atomic_load_explicit(&s->comp[edge->dest], memory_order_relaxed)
+                                 : cu;
+        bool mutual = atomic_load_explicit(&s->best[other], memory_order_relaxed) == key;
+        if (mutual && c < other) continue;
+
+        s->next[c] = other;
+        long long slot = atomic_fetch_add_explicit(&s->result_size, 1, memory_order_relaxed);
+        s->result->edges[slot] = *edge;
+        atomic_fetch_add_explicit(&s->total_weight, edge->weight, memory_order_relaxed);
+    }
+}
+
+// Hook after all choices are made, so chooseParents saw flat labels
+static void applyParents(void *context, long long begin, long long end, int thread) {
+    (void)thread;
+    BoruvkaState *s = (BoruvkaState*)context;
+    for (long long c = begin; c < end; c++) {
+        if (s->next[c] != (int)c) atomic_store_explicit(&s->comp[c], s->next[c], memory_order_relaxed);
+        atomic_store_explicit(&s->best[c], NO_EDGE, memory_order_relaxed);
+    }
+}
+
+// Pointer jumping: point every vertex straight at its new root
+static void flattenLabels(void *context, long long begin, long long end, int thread) {
+    (void)thread;
+    BoruvkaState *s = (BoruvkaState*)context;
+    for (long long v = begin; v < end; v++) {
+        int root = atomic_load_explicit(&s->comp[v], memory_order_relaxed);
+        int up = atomic_load_explicit(&s->comp[root], memory_order_relaxed);
+        while (up != root) {
+            root = up;
+            up = atomic_load_explicit(&s->comp[root], memory_order_relaxed);
+        }
+        atomic_store_explicit(&s->comp[v], root, memory_order_relaxed);
+    }
+}
+
+MSTResult* mstBoruvka(const CSRGraph *graph, int num_threads) {
+    int n = graph->num_vertices;
+    if (num_threads < 1) num_threads = 1;
+    size_t slots = n > 0 ? (size_t)n : 1;
+
+    BoruvkaState s;
+    s.edges = extractEdges(graph, &s.num_edges);
+    s.comp = (_Atomic int*)malloc(slots * sizeof(_Atomic int));
+    s.best = (_Atomic uint64_t*)malloc(slots * sizeof(_Atomic uint64_t));
+    s.next = (int*)malloc(slots * sizeof(int));
+    for (int v = 0; v < n; v++) {
+        atomic_init(&s.comp[v], v);
+        atomic_init(&s.best[v], NO_EDGE);
+    }
+    s.result = createMSTResult(n);
+    atomic_init(&s.result_size, 0);
+    atomic_init(&s.total_weight, 0);
+
+    // Each round at least halves the number of components that still
+    // have outgoing edges
+    long long before;
+    do {
+        before = atomic_load(&s.result_size);
+        parallelFor(s.num_edges, MST_CHUNK, num_threads, findLightestEdges, &s);
+        parallelFor(n, MST_CHUNK, num_threads, chooseParents, &s);
+        parallelFor(n, MST_CHUNK, num_threads, applyParents, &s);
+        parallelFor(n, MST_CHUNK, num_threads, flattenLabels, &s);
+    } while (atomic_load(&s.result_size) > before);
+
+    s.result->num_edges = atomic_load(&s.result_size);
+    s.result->total_weight = atomic_load(&s.total_weight);
+
+    free(s.edges);
+    free((void*)s.comp);
+    free((void*)s.best);
+    free(s.next);
+    return s.result;
+}
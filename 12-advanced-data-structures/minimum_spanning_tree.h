@@ -0,0 +1,45 @@
+/*
+ * minimum_spanning_tree.h
+ * Minimum spanning forests of weighted undirected CSR graphs
+ *
+ * mstKruskal() - sort all edges by weight (chunks sorted in parallel,
+ *                then merged pairwise with every round split across
+ *                threads by co-rank), then add each edge that
+ *                joins two union-find sets
+ * mstBoruvka() - rounds in which every component picks its lightest
+ *                outgoing edge in parallel (atomic min on a packed
+ *                weight/edge-id key), hooks along it, and flattens
+ *
+ * Both return forests of the same (minimum) total weight, though with
+ * tied weights they may pick different edges. A disconnected graph
+ * gets one tree per component. Arcs of a directed graph are treated as
+ * undirected edges. Weights must be non-negative (Boruvka packs them
+ * into unsigned keys).
+ */
+
+#ifndef MINIMUM_SPANNING_TREE_H
+#define MINIMUM_SPANNING_TREE_H
+
+#include "csr_graph.h"
+
+typedef struct {
+    Edge *edges;            // num_vertices - components entries
+    long long num_edges;
+    long long total_weight;
+} MSTResult;
+
+/**
+ * @brief Kruskal's algorithm with a parallel edge sort
+ * @return Spanning forest (free with freeMSTResult)
+ */
+MSTResult* mstKruskal(const CSRGraph *graph, int num_threads);
+
+/**
+ * @brief Parallel Boruvka
+ * @return Spanning forest (free with freeMSTResult)
+ */
+MSTResult* mstBoruvka(const CSRGraph *graph, int num_threads);
+
+void freeMSTResult(MSTResult *result);
+
+#endif /* MINIMUM_SPANNING_TREE_H */
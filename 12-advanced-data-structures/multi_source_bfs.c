@@ -0,0 +1,125 @@
+/*
+ * multi_source_bfs.c
+ * Bit-parallel multi-source BFS over CSR graphs
+ * Topics: bitmask frontiers, sharing edge scans between searches,
+ *         sparse frontier lists
+ */
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "multi_source_bfs.h"
+
+typedef struct {
+    uint64_t *seen;         // Bit i: search i has reached the vertex
+    uint64_t *visit;        // Bit i: vertex is on search i's frontier
+    uint64_t *visit_next;
+    int *frontier;          // Vertices with visit != 0
+    int *next_frontier;
+} MSBFSState;
+
+// One batch of up to 64 searches; dist rows and ecc may be NULL
+static void runBatch(const CSRGraph *graph, MSBFSState *state, const int *sources,
+                     int count, int *dist, int *ecc) {
+    int n = graph->num_vertices;
+    uint64_t *seen = state->seen;
+    uint64_t *visit = state->visit;
+    uint64_t *visit_next = state->visit_next;
+    int frontier_size = 0;
+
+    memset(seen, 0, n * sizeof(uint64_t));
+    for (int i = 0; i < count; i++) {
+        int s = sources[i];
+        if (visit[s] == 0) state->frontier[frontier_size++] = s;
+        seen[s] |= 1ULL << i;
+        visit[s] |= 1ULL << i;
+        if (dist != NULL) dist[(long long)i * n + s] = 0;
+        if (ecc != NULL) ecc[i] = 0;
+    }
+
+    for (int level = 1; frontier_size > 0; level++) {
+        int next_size = 0;
+
+        // Expand: each edge scan serves every search with v on its frontier
+        for (int f = 0; f < frontier_size; f++) {
+            int v = state->frontier[f];
+            uint64_t searches = visit[v];
+            for (long long e = graph->offsets[v]; e < graph->offsets[v + 1]; e++) {
+                int u = graph->targets[e];
+                uint64_t fresh = searches & ~seen[u];
+                if (fresh != 0) {
+                    if (visit_next[u] == 0) state->next_frontier[next_size++] = u;
+                    visit_next[u] |= fresh;
+                }
+            }
+            visit[v] = 0;
+        }
+
+        // Commit the level: mark seen and record distances per search
+        uint64_t reached = 0;
+        for (int f = 0; f < next_size; f++) {
+            int u = state->next_frontier[f];
+            uint64_t fresh = visit_next[u];
+            seen[u] |= fresh;
+            reached |= fresh;
+            if (dist != NULL) {
+                for (uint64_t bits = fresh; bits != 0; bits &= bits - 1) {
+                    int i = __builtin_ctzll(bits);
+                    dist[(long long)i * n + u] = level;
+                }
+            }
+        }
+        if (ecc != NULL) {
+            for (uint64_t bits = reached; bits != 0; bits &= bits - 1) {
+                ecc[__builtin_ctzll(bits)] = level;
+            }
+        }
+
+        // visit is all zero again, so it becomes the next visit_next
+        uint64_t *tmp_masks = visit;
+        visit = visit_next;
+        visit_next = tmp_masks;
+        int *tmp_list = state->frontier;
+        state->frontier = state->next_frontier;
+        state->next_frontier = tmp_list;
+        frontier_size = next_size;
+    }
+
+    state->visit = visit;
+    state->visit_next = visit_next;
+}
+
+static void runAllBatches(const CSRGraph *graph, const int *sources, int num_sources,
+                          int *dist, int *ecc) {
+    int n = graph->num_vertices;
+    size_t words = n > 0 ? (size_t)n : 1;
+    MSBFSState state;
+    state.seen = (uint64_t*)malloc(words * sizeof(uint64_t));
+    state.visit = (uint64_t*)calloc(words, sizeof(uint64_t));
+    state.visit_next = (uint64_t*)calloc(words, sizeof(uint64_t));
+    state.frontier = (int*)malloc(words * sizeof(int));
+    state.next_frontier = (int*)malloc(words * sizeof(int));
+
+    for (int first = 0; first < num_sources; first += MSBFS_BATCH) {
+        int count = num_sources - first < MSBFS_BATCH ? num_sources - first : MSBFS_BATCH;
+        runBatch(graph, &state, sources + first, count,
+                 dist != NULL ? dist + (long long)first * n : NULL,
+                 ecc != NULL ? ecc + first : NULL);
+    }
+
+    free(state.seen);
+    free(state.visit);
+    free(state.visit_next);
+    free(state.frontier);
+    free(state.next_frontier);
+}
+
+void msbfsDistances(const CSRGraph *graph, const int *sources, int num_sources, int *dist) {
+    long long total = (long long)num_sources * graph->num_vertices;
+    for (long long i = 0; i < total; i++) dist[i] = -1;
+    runAllBatches(graph, sources, num_sources, dist, NULL);
+}
+
+void msbfsEccentricities(const CSRGraph *graph, const int *sources, int num_sources, int *ecc) {
+    runAllBatches(graph, sources, num_sources, NULL, ecc);
+}
@@ -0,0 +1,349 @@
+/*
+ * multiqueue.c
+ * Relaxed concurrent priority queue (MultiQueue)
+ * Topics: c*threads internal min-heaps, try-lock, power-of-two-choices
+ *         delete-min, throughput and rank-error measurement
+ *
+ * A single Heap behind one mutex serializes every thread. A MultiQueue
+ * spreads the elements over c*T small heaps, each with its own lock:
+ *   - insert:     push into a random heap that can be locked right now
+ *   - delete-min: look at the tops of two random heaps, pop the smaller
+ * The answer is not always the global minimum, but it is close to it
+ * ("rank error"), and threads almost never wait for each other.
+ * Larger c means less contention but a larger rank error.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include <time.h>
+
+#define CACHE_LINE 64
+#define EMPTY_TOP INT_MAX
+
+typedef struct {
+    int priority;
+    int task_id;
+} Task;
+
+// One internal heap with its own lock, padded to avoid false sharing
+typedef struct {
+    _Alignas(CACHE_LINE) pthread_mutex_t lock;
+    atomic_int top;          // Cached priority of data[0], EMPTY_TOP if empty
+    Task *data;
+    int size;
+    int capacity;
+} LockedHeap;
+
+typedef struct {
+    LockedHeap *heaps;
+    int num_heaps;
+} MultiQueue;
+
+// Per-thread xorshift random generator (no shared state)
+static inline uint32_t nextRandom(uint32_t *state) {
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+static inline int randomHeap(MultiQueue *mq, uint32_t *rng) {
+    return (int)(((uint64_t)nextRandom(rng) * (uint64_t)mq->num_heaps) >> 32);
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// ===== Sequential min-heap of Tasks (same shape as heap_priority_queue.c) =====
+
+static void heapPush(LockedHeap *h, Task task) {
+    if (h->size == h->capacity) {
+        h->capacity = h->capacity ? h->capacity * 2 : 64;
+        h->data = (Task*)realloc(h->data, h->capacity * sizeof(Task));
+    }
+    int index = h->size++;
+    while (index > 0) {
+        int parent_idx = (index - 1) / 2;
+        if (h->data[parent_idx].priority <= task.priority) break;
+        h->data[index] = h->data[parent_idx];
+        index = parent_idx;
+    }
+    h->data[index] = task;
+}
+
+static Task heapPop(LockedHeap *h) {
+    Task root = h->data[0];
+    Task last = h->data[--h->size];
+    int index = 0;
+    while (true) {
+        int child = 2 * index + 1;
+        if (child >= h->size) break;
+        if (child + 1 < h->size && h->data[child + 1].priority < h->data[child].priority) {
+            child++;
+        }
+        if (last.priority <= h->data[child].priority) break;
+        h->data[index] = h->data[child];
+        index = child;
+    }
+    if (h->size > 0) h->data[index] = last;
+    return root;
+}
+
+static inline void updateTop(LockedHeap *h) {
+    atomic_store_explicit(&h->top, h->size > 0 ? h->data[0].priority : EMPTY_TOP,
+                          memory_order_release);
+}
+
+// ===== MultiQueue =====
+
+// Create a MultiQueue with c * num_threads internal heaps
+MultiQueue* createMultiQueue(int c, int num_threads) {
+    MultiQueue *mq = (MultiQueue*)malloc(sizeof(MultiQueue));
+    mq->num_heaps = c * num_threads < 1 ? 1 : c * num_threads;
+    mq->heaps = (LockedHeap*)aligned_alloc(CACHE_LINE,
+                                           mq->num_heaps * sizeof(LockedHeap));
+    for (int i = 0; i < mq->num_heaps; i++) {
+        pthread_mutex_init(&mq->heaps[i].lock, NULL);
+        atomic_init(&mq->heaps[i].top, EMPTY_TOP);
+        mq->heaps[i].data = NULL;
+        mq->heaps[i].size = 0;
+        mq->heaps[i].capacity = 0;
+    }
+    return mq;
+}
+
+// Insert into a random heap whose lock is free right now
+void mqInsert(MultiQueue *mq, Task task, uint32_t *rng) {
+    while (true) {
+        LockedHeap *h = &mq->heaps[randomHeap(mq, rng)];
+        if (pthread_mutex_trylock(&h->lock) != 0) {
+            continue;
+        }
+        heapPush(h, task);
+        updateTop(h);
+        pthread_mutex_unlock(&h->lock);
+        return;
+    }
+}
+
+// Delete an approximate minimum: best of two random heap tops.
+// Returns false once every heap has been seen empty.
+bool mqDeleteMin(MultiQueue *mq, Task *out, uint32_t *rng) {
+    int attempts = 0;
+    while (true) {
+        int a = randomHeap(mq, rng);
+        int b = randomHeap(mq, rng);
+        int top_a = atomic_load_explicit(&mq->heaps[a].top, memory_order_acquire);
+        int top_b = atomic_load_explicit(&mq->heaps[b].top, memory_order_acquire);
+        int pick = top_b < top_a ? b : a;
+
+        if ((top_a == EMPTY_TOP && top_b == EMPTY_TOP) || ++attempts > 4 * mq->num_heaps) {
+            // Random probes keep missing: fall back to a full scan before giving up
+            bool any = false;
+            for (int i = 0; i < mq->num_heaps; i++) {
+                if (atomic_load_explicit(&mq->heaps[i].top, memory_order_acquire) != EMPTY_TOP) {
+                    any = true;
+                    pick = i;
+                    break;
+                }
+            }
+            if (!any) return false;
+            attempts = 0;
+        }
+
+        LockedHeap *h = &mq->heaps[pick];
+        if (pthread_mutex_trylock(&h->lock) != 0) {
+            continue;
+        }
+        if (h->size == 0) {
+            pthread_mutex_unlock(&h->lock);
+            continue;
+        }
+        *out = heapPop(h);
+        updateTop(h);
+        pthread_mutex_unlock(&h->lock);
+        return true;
+    }
+}
+
+void freeMultiQueue(MultiQueue *mq) {
+    for (int i = 0; i < mq->num_heaps; i++) {
+        pthread_mutex_destroy(&mq->heaps[i].lock);
+        free(mq->heaps[i].data);
+    }
+    free(mq->heaps);
+    free(mq);
+}
+
+// ===== Throughput benchmark =====
+
+typedef struct {
+    MultiQueue *mq;
+    int thread_id;
+    int ops;
+    long long deleted;
+} WorkerArgs;
+
+// Each worker alternates insert and delete-min, like a scheduler
+// that pushes follow-up tasks while draining the queue
+static void* worker(void *arg) {
+    WorkerArgs *w = (WorkerArgs*)arg;
+    uint32_t rng = 0x9E3779B9u ^ (uint32_t)(w->thread_id * 7919 + 1);
+    Task task;
+    for (int i = 0; i < w->ops; i++) {
+        Task t = { (int)(nextRandom(&rng) & 0x7FFFFFF), w->thread_id };
+        mqInsert(w->mq, t, &rng);
+        if (mqDeleteMin(w->mq, &task, &rng)) {
+            w->deleted++;
+        }
+    }
+    return NULL;
+}
+
+double benchmarkThroughput(int c, int num_threads, int ops_per_thread, int prefill) {
+    MultiQueue *mq = createMultiQueue(c, num_threads);
+    uint32_t rng = 12345;
+    for (int i = 0; i < prefill; i++) {
+        Task t = { (int)(nextRandom(&rng) & 0x7FFFFFF), -1 };
+        mqInsert(mq, t, &rng);
+    }
+
+    pthread_t *threads = (pthread_t*)malloc(num_threads * sizeof(pthread_t));
+    WorkerArgs *args = (WorkerArgs*)calloc(num_threads, sizeof(WorkerArgs));
+
+    double start = nowSeconds();
+    for (int i = 0; i < num_threads; i++) {
+        args[i].mq = mq;
+        args[i].thread_id = i;
+        args[i].ops = ops_per_thread;
+        pthread_create(&threads[i], NULL, worker, &args[i]);
+    }
+    for (int i = 0; i < num_threads; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    double elapsed = nowSeconds() - start;
+
+    free(threads);
+    free(args);
+    freeMultiQueue(mq);
+
+    // Each iteration is one insert plus one delete-min
+    return 2.0 * num_threads * ops_per_thread / elapsed;
+}
+
+// ===== Rank-error quality =====
+
+// Fenwick tree over priorities 0..n-1 counts how many remaining
+// elements are smaller than the one just deleted (its rank error)
+static void fenwickAdd(int *tree, int n, int index, int delta) {
+    for (index++; index <= n; index += index & -index) tree[index] += delta;
+}
+
+static int fenwickPrefix(int *tree, int n, int index) {
+    int sum = 0;
+    if (index > n) index = n;
+    for (; index > 0; index -= index & -index) sum += tree[index];
+    return sum;
+}
+
+// Replays delete-min sequentially on a queue sized for num_threads
+// and reports mean and max rank of the returned elements (0 = exact)
+void measureRankError(int c, int num_threads, int n, double *mean, int *max) {
+    MultiQueue *mq = createMultiQueue(c, num_threads);
+    int *tree = (int*)calloc(n + 1, sizeof(int));
+    int *perm = (int*)malloc(n * sizeof(int));
+    uint32_t rng = 424242;
+
+    for (int i = 0; i < n; i++) perm[i] = i;
+    for (int i = n - 1; i > 0; i--) {
+        int j = (int)(nextRandom(&rng) % (uint32_t)(i + 1));
+        int tmp = perm[i]; perm[i] = perm[j]; perm[j] = tmp;
+    }
+    for (int i = 0; i < n; i++) {
+        Task t = { perm[i], i };
+        mqInsert(mq, t, &rng);
+        fenwickAdd(tree, n, perm[i], 1);
+    }
+
+    long long total = 0;
+    int worst = 0;
+    Task task;
+    for (int i = 0; i < n && mqDeleteMin(mq, &task, &rng); i++) {
+        int rank = fenwickPrefix(tree, n, task.priority);
+        fenwickAdd(tree, n, task.priority, -1);
+        total += rank;
+        if (rank > worst) worst = rank;
+    }
+
+    *mean = (double)total / n;
+    *max = worst;
+    free(tree);
+    free(perm);
+    freeMultiQueue(mq);
+}
+
+int main(int argc, char *argv[]) {
+    printf("=== Relaxed Concurrent Priority Queue (MultiQueue) ===\n\n");
+
+    int max_threads = argc > 1 ? atoi(argv[1]) : 4;
+    int ops = argc > 2 ? atoi(argv[2]) : 200000;
+    if (max_threads < 1) max_threads = 1;
+
+    // Basic usage
+    printf("1. Basic Operations (c=2, 2 threads -> 4 heaps):\n");
+    MultiQueue *mq = createMultiQueue(2, 2);
+    uint32_t rng = 1;
+    int priorities[] = {50, 10, 40, 20, 30, 5, 60};
+    printf("   Inserting task priorities: ");
+    for (int i = 0; i < 7; i++) {
+        Task t = { priorities[i], i };
+        mqInsert(mq, t, &rng);
+        printf("%d ", priorities[i]);
+    }
+    printf("\n   Delete-min order (approximate): ");
+    Task task;
+    while (mqDeleteMin(mq, &task, &rng)) {
+        printf("%d ", task.priority);
+    }
+    printf("\n\n");
+    freeMultiQueue(mq);
+
+    // Throughput
+    printf("2. Throughput (insert + delete-min pairs, %d ops/thread):\n", ops);
+    printf("   %-8s %-4s %16s\n", "threads", "c", "ops/sec");
+    int cs[] = {1, 2, 4, 8};
+    for (int t = 1; t <= max_threads; t *= 2) {
+        for (int ci = 0; ci < 4; ci++) {
+            double rate = benchmarkThroughput(cs[ci], t, ops, 100000);
+            printf("   %-8d %-4d %16.0f\n", t, cs[ci], rate);
+        }
+    }
+    printf("\n");
+
+    // Quality
+    int n = 200000;
+    printf("3. Rank Error (%d elements, sequential replay, %d threads):\n", n, max_threads);
+    printf("   %-4s %-8s %12s %10s\n", "c", "heaps", "mean rank", "max rank");
+    for (int ci = 0; ci < 4; ci++) {
+        double mean;
+        int worst;
+        measureRankError(cs[ci], max_threads, n, &mean, &worst);
+        printf("   %-4d %-8d %12.2f %10d\n", cs[ci], cs[ci] * max_threads, mean, worst);
+    }
+    printf("\n   Larger c: fewer lock collisions, larger rank error.\n");
+    printf("   Usage: ./multiqueue [max_threads] [ops_per_thread]\n");
+
+    return 0;
+}
@@ -0,0 +1,264 @@
+/*
+ * pagerank.c
+ * Pull-based PageRank with barrier-synchronized worker threads
+ * Topics: SpMV over CSR, edge-balanced static partitioning, dangling
+ *         vertices, float32 vs float64 bandwidth
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include <pthread.h>
+#include "pagerank.h"
+
+PageRankOptions pageRankDefaults(void) {
+    PageRankOptions options = { 0.85, 1e-6, 100, 1, false };
+    return options;
+}
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// In-edges of a directed graph: count, prefix-sum, scatter
+static void transposeArcs(const CSRGraph *graph, long long **in_offsets, int **in_sources) {
+    int n = graph->num_vertices;
+    long long *offsets = (long long*)calloc((size_t)n + 1, sizeof(long long));
+    int *sources = (int*)malloc((graph->num_arcs > 0 ? graph->num_arcs : 1) * sizeof(int));
+
+    for (long long i = 0; i < graph->num_arcs; i++) {
+        offsets[graph->targets[i] + 1]++;
+    }
+    for (int v = 0; v < n; v++) {
+        offsets[v + 1] += offsets[v];
+    }
+    long long *cursor = (long long*)malloc(((size_t)n + 1) * sizeof(long long));
+    for (int v = 0; v <= n; v++) cursor[v] = offsets[v];
+    for (int u = 0; u < n; u++) {
+        for (long long i = graph->offsets[u]; i < graph->offsets[u + 1]; i++) {
+            sources[cursor[graph->targets[i]]++] = u;
+        }
+    }
+    free(cursor);
+
+    *in_offsets = offsets;
+    *in_sources = sources;
+}
+
+typedef struct {
+    const CSRGraph *graph;          // Out-degrees come from here
+    const long long *in_offsets;
+    const int *in_sources;
+    PageRankOptions options;
+
+    void *rank;                     // float or double, per options.use_float
+    void *contrib;                  // rank / out_degree, 0 for dangling vertices
+    int *bounds;                    // Thread t owns [bounds[t], bounds[t + 1])
+    double *partial_dangling;       // One slot per thread
+    double *partial_error;
+
+    PageRankResult *result;
+    pthread_barrier_t barrier;
+} PageRankShared;
+
+typedef struct {
+    PageRankShared *shared;
+    int id;
+} PageRankWorker;
+
+// Phase 1: per-vertex contribution; returns rank held by dangling vertices
+static double scatterContributions(PageRankShared *s, int begin, int end) {
+    const long long *out = s->graph->offsets;
+    double dangling = 0;
+    if (s->options.use_float) {
+        const float *rank = (const float*)s->rank;
+        float *contrib = (float*)s->contrib;
+        for (int v = begin; v < end; v++) {
+            long long degree = out[v + 1] - out[v];
+            contrib[v] = degree > 0 ? rank[v] / degree : 0.0f;
+            if (degree == 0) dangling += rank[v];
+        }
+    } else {
+        const double *rank = (const double*)s->rank;
+        double *contrib = (double*)s->contrib;
+        for (int v = begin; v < end; v++) {
+            long long degree = out[v + 1] - out[v];
+            contrib[v] = degree > 0 ? rank[v] / degree : 0.0;
+            if (degree == 0) dangling += rank[v];
+        }
+    }
+    return dangling;
+}
+
+// Phase 2: pull from in-neighbors; returns the L1 change of the range.
+// Sums are accumulated in double even when ranks are stored as float.
+static double pullRanks(PageRankShared *s, int begin, int end, double base) {
+    const long long *in_offsets = s->in_offsets;
+    const int *in_sources = s->in_sources;
+    double damping = s->options.damping;
+    double error = 0;
+    if (s->options.use_float) {
+        float *rank = (float*)s->rank;
+        const float *contrib = (const float*)s->contrib;
+        for (int v = begin; v < end; v++) {
+            double sum = 0;
+            for (long long i = in_offsets[v]; i < in_offsets[v + 1]; i++) {
+                sum += contrib[in_sources[i]];
+            }
+            double updated = base + damping * sum;
+            error += fabs(updated - rank[v]);
+            rank[v] = (float)updated;
+        }
+    } else {
+        double *rank = (double*)s->rank;
+        const double *contrib = (const double*)s->contrib;
+        for (int v = begin; v < end; v++) {
+            double sum = 0;
+            for (long long i = in_offsets[v]; i < in_offsets[v + 1]; i++) {
+                sum += contrib[in_sources[i]];
+            }
+            double updated = base + damping * sum;
+            error += fabs(updated - rank[v]);
+            rank[v] = updated;
+        }
+    }
+    return error;
+}
+
+static void* pageRankWorker(void *arg) {
+    PageRankWorker *w = (PageRankWorker*)arg;
+    PageRankShared *s = w->shared;
+    int num_threads = s->options.num_threads;
+    int n = s->graph->num_vertices;
+    int begin = s->bounds[w->id];
+    int end = s->bounds[w->id + 1];
+
+    for (int iter = 0; iter < s->options.max_iterations; iter++) {
+        double start = nowSeconds();
+        s->partial_dangling[w->id] = scatterContributions(s, begin, end);
+        pthread_barrier_wait(&s->barrier);
+
+        // Every thread sums the partials itself: no extra barrier needed
+        double dangling = 0;
+        for (int t = 0; t < num_threads; t++) dangling += s->partial_dangling[t];
+        double base = (1.0 - s->options.damping) / n + s->options.damping * dangling / n;
+
+        s->partial_error[w->id] = pullRanks(s, begin, end, base);
+        pthread_barrier_wait(&s->barrier);
+
+        double error = 0;
+        for (int t = 0; t < num_threads; t++) error += s->partial_error[t];
+        if (w->id == 0) {
+            s->result->iteration_seconds[iter] = nowSeconds() - start;
+            s->result->iterations = iter + 1;
+            s->result->final_error = error;
+        }
+        if (error < s->options.tolerance) break;
+    }
+    return NULL;
+}
+
+PageRankResult* pageRank(const CSRGraph *graph, const PageRankOptions *options) {
+    PageRankShared shared;
+    shared.graph = graph;
+    shared.options = options != NULL ? *options : pageRankDefaults();
+    if (shared.options.num_threads < 1) shared.options.num_threads = 1;
+    if (shared.options.max_iterations < 0) shared.options.max_iterations = 0;
+    int num_threads = shared.options.num_threads;
+    int n = graph->num_vertices;
+    size_t slots = n > 0 ? (size_t)n : 1;
+
+    PageRankResult *result = (PageRankResult*)malloc(sizeof(PageRankResult));
+    result->num_vertices = n;
+    result->scores = (double*)malloc(slots * sizeof(double));
+    result->iterations = 0;
+    result->final_error = 0;
+    result->iteration_seconds = (double*)calloc(shared.options.max_iterations + 1, sizeof(double));
+    if (n == 0) {
+        result->bytes_per_iteration = 0;
+        return result;
+    }
+
+    long long *in_offsets = graph->offsets;
+    int *in_sources = graph->targets;
+    if (graph->directed) transposeArcs(graph, &in_offsets, &in_sources);
+    shared.in_offsets = in_offsets;
+    shared.in_sources = in_sources;
+
+    size_t value_size = shared.options.use_float ? sizeof(float) : sizeof(double);
+    shared.rank = malloc(slots * value_size);
+    shared.contrib = malloc(slots * value_size);
+    for (int v = 0; v < n; v++) {
+        if (shared.options.use_float) {
+            ((float*)shared.rank)[v] = 1.0f / n;
+        } else {
+            ((double*)shared.rank)[v] = 1.0 / n;
+        }
+    }
+
+    // Split vertices so each thread pulls over about the same number of arcs
+    shared.bounds = (int*)malloc((num_threads + 1) * sizeof(int));
+    shared.bounds[0] = 0;
+    for (int t = 1; t < num_threads; t++) {
+        long long target = in_offsets[n] * t / num_threads;
+        int lo = shared.bounds[t - 1], hi = n;
+        while (lo < hi) {
+            int mid = lo + (hi - lo) / 2;
+            if (in_offsets[mid] < target) lo = mid + 1; else hi = mid;
+        }
+        shared.bounds[t] = lo;
+    }
+    shared.bounds[num_threads] = n;
+
+    shared.partial_dangling = (double*)calloc(num_threads, sizeof(double));
+    shared.partial_error = (double*)calloc(num_threads, sizeof(double));
+    shared.result = result;
+    pthread_barrier_init(&shared.barrier, NULL, num_threads);
+
+    pthread_t *threads = (pthread_t*)malloc(num_threads * sizeof(pthread_t));
+    PageRankWorker *workers = (PageRankWorker*)malloc(num_threads * sizeof(PageRankWorker));
+    for (int t = 0; t < num_threads; t++) {
+        workers[t].shared = &shared;
+        workers[t].id = t;
+        if (t > 0) pthread_create(&threads[t], NULL, pageRankWorker, &workers[t]);
+    }
+    pageRankWorker(&workers[0]);
+    for (int t = 1; t < num_threads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    for (int v = 0; v < n; v++) {
+        result->scores[v] = shared.options.use_float ? ((float*)shared.rank)[v]
+                                                     : ((double*)shared.rank)[v];
+    }
+
+    // Per vertex: out and in offsets, rank read twice and written once,
+    // contrib written once. Per arc: one source id, one gathered contrib
+    result->bytes_per_iteration = (double)n * (2 * sizeof(long long) + 4 * value_size) +
+                                  (double)in_offsets[n] * (sizeof(int) + value_size);
+
+    if (graph->directed) {
+        free(in_offsets);
+        free(in_sources);
+    }
+    free(workers);
+    free(threads);
+    free(shared.rank);
+    free(shared.contrib);
+    free(shared.bounds);
+    free(shared.partial_dangling);
+    free(shared.partial_error);
+    pthread_barrier_destroy(&shared.barrier);
+    return result;
+}
+
+void freePageRankResult(PageRankResult *result) {
+    if (result == NULL) return;
+    free(result->scores);
+    free(result->iteration_seconds);
+    free(result);
+}
@@ -0,0 +1,54 @@
+/*
+ * pagerank.h
+ * Parallel pull-based PageRank on a CSR graph
+ *
+ * Each iteration is one sparse matrix-vector product: every vertex
+ * pulls rank / out_degree from its in-neighbors, so each thread only
+ * writes its own vertices and needs no atomics. Rank held by dangling
+ * vertices (no out-edges) is spread evenly over all vertices, so the
+ * scores always sum to 1. The sweep streams the in-edge arrays and
+ * gathers one value per edge, so it is bound by memory bandwidth;
+ * float32 storage halves the gathered bytes.
+ */
+
+#ifndef PAGERANK_H
+#define PAGERANK_H
+
+#include <stdbool.h>
+#include "csr_graph.h"
+
+typedef struct {
+    double damping;         // Probability of following a link (0.85)
+    double tolerance;       // Stop once an iteration changes ranks by less (L1)
+    int max_iterations;
+    int num_threads;
+    bool use_float;         // Keep ranks in float32 during the iterations
+} PageRankOptions;
+
+typedef struct {
+    int num_vertices;
+    double *scores;             // Sum to 1
+    int iterations;
+    double final_error;         // L1 change of the last iteration
+    double *iteration_seconds;  // One entry per iteration
+    double bytes_per_iteration; // Estimated memory traffic of one sweep
+} PageRankResult;
+
+/**
+ * @brief Damping 0.85, tolerance 1e-6, 100 iterations, 1 thread, double
+ */
+PageRankOptions pageRankDefaults(void);
+
+/**
+ * @brief Iterate PageRank until converged or max_iterations
+ * @param options NULL for pageRankDefaults()
+ * @return Scores and per-iteration timings (free with freePageRankResult)
+ *
+ * Directed graphs are transposed once up front to get in-edges;
+ * undirected graphs already store every arc both ways.
+ */
+PageRankResult* pageRank(const CSRGraph *graph, const PageRankOptions *options);
+
+void freePageRankResult(PageRankResult *result);
+
+#endif /* PAGERANK_H */
@@ -0,0 +1,324 @@
+/*
+ * parallel_bfs.c
+ * Direction-optimizing BFS with bitmap frontiers
+ * Topics: top-down / bottom-up switching, atomic bitmaps,
+ *         per-thread local queues, barrier-driven phases
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "parallel_bfs.h"
+
+#define QUEUE_CHUNK 64      // Frontier vertices taken per grab
+#define WORD_CHUNK 16       // Bitmap words (x64 vertices) taken per grab
+
+typedef enum {
+    PHASE_TOP_DOWN,
+    PHASE_BOTTOM_UP,
+    PHASE_QUEUE_TO_BITMAP,
+    PHASE_BITMAP_TO_QUEUE,
+    PHASE_DONE
+} BFSPhase;
+
+typedef struct {
+    const CSRGraph *graph;
+    int *parent;
+    long long num_words;
+
+    _Atomic uint64_t *visited;
+    _Atomic uint64_t *front;     // Frontier bitmap (bottom-up)
+    _Atomic uint64_t *next;      // Next frontier bitmap (bottom-up)
+    int *queue;                  // Frontier queue (top-down)
+    int *next_queue;
+    long long queue_size;
+
+    BFSPhase phase;
+    atomic_llong next_index;     // Work distribution cursor
+    atomic_llong next_tail;      // Append cursor into next_queue
+    atomic_llong scout_count;    // Degrees of vertices found top-down
+    atomic_llong awake_count;    // Vertices found bottom-up
+    pthread_barrier_t barrier;
+} BFSShared;
+
+typedef struct {
+    BFSShared *shared;
+    int id;
+    int *local_queue;
+    long long local_capacity;
+} BFSWorker;
+
+static inline bool testBit(_Atomic uint64_t *bits, int v) {
+    return (atomic_load_explicit(&bits[v >> 6], memory_order_relaxed) >> (v & 63)) & 1;
+}
+
+static void localPush(BFSWorker *w, long long *size, int v) {
+    if (*size == w->local_capacity) {
+        w->local_capacity = w->local_capacity ? w->local_capacity * 2 : 1024;
+        w->local_queue = (int*)realloc(w->local_queue, w->local_capacity * sizeof(int));
+    }
+    w->local_queue[(*size)++] = v;
+}
+
+// Publish a thread's discoveries into next_queue with one atomic add
+static void flushLocal(BFSWorker *w, long long size) {
+    BFSShared *s = w->shared;
+    if (size == 0) return;
+    long long offset = atomic_fetch_add(&s->next_tail, size);
+    memcpy(s->next_queue + offset, w->local_queue, size * sizeof(int));
+}
+
+static void topDownStep(BFSWorker *w) {
+    BFSShared *s = w->shared;
+    const CSRGraph *graph = s->graph;
+    long long found = 0, scout = 0;
+
+    while (true) {
+        long long begin = atomic_fetch_add(&s->next_index, QUEUE_CHUNK);
+        if (begin >= s->queue_size) break;
+        long long end = begin + QUEUE_CHUNK < s->queue_size ? begin + QUEUE_CHUNK : s->queue_size;
+
+        for (long long f = begin; f < end; f++) {
+            int u = s->queue[f];
+            for (long long i = graph->offsets[u]; i < graph->offsets[u + 1]; i++) {
+                int v = graph->targets[i];
+                if (testBit(s->visited, v)) continue;
+                uint64_t bit = 1ULL << (v & 63);
+                uint64_t old = atomic_fetch_or_explicit(&s->visited[v >> 6], bit,
+                                                        memory_order_relaxed);
+                if (!(old & bit)) {
+                    s->parent[v] = u;
+                    localPush(w, &found, v);
+                    scout += csrDegree(graph, v);
+                }
+            }
+        }
+    }
+
+    flushLocal(w, found);
+    atomic_fetch_add(&s->scout_count, scout);
+}
+
+// Each thread owns whole bitmap words, so visited/next are written
+// without read-modify-write atomics
+static void bottomUpStep(BFSWorker *w) {
+    BFSShared *s = w->shared;
+    const CSRGraph *graph = s->graph;
+    int n = graph->num_vertices;
+    long long awake = 0;
+
+    while (true) {
+        long long begin = atomic_fetch_add(&s->next_index, WORD_CHUNK);
+        if (begin >= s->num_words) break;
+        long long end = begin + WORD_CHUNK < s->num_words ? begin + WORD_CHUNK : s->num_words;
+
+        for (long long word = begin; word < end; word++) {
+            uint64_t seen = atomic_load_explicit(&s->visited[word], memory_order_relaxed);
+            uint64_t found = 0;
+            int base = (int)(word << 6);
+            for (int b = 0; b < 64 && base + b < n; b++) {
+                if ((seen >> b) & 1) continue;
+                int v = base + b;
+                for (long long i = graph->offsets[v]; i < graph->offsets[v + 1]; i++) {
+                    int u = graph->targets[i];
+                    if (testBit(s->front, u)) {
+                        s->parent[v] = u;
+                        found |= 1ULL << b;
+                        awake++;
+                        break;
+                    }
+                }
+            }
+            atomic_store_explicit(&s->next[word], found, memory_order_relaxed);
+            if (found) {
+                atomic_store_explicit(&s->visited[word], seen | found, memory_order_relaxed);
+            }
+        }
+    }
+
+    atomic_fetch_add(&s->awake_count, awake);
+}
+
+static void queueToBitmap(BFSWorker *w) {
+    BFSShared *s = w->shared;
+
+    while (true) {
+        long long begin = atomic_fetch_add(&s->next_index, QUEUE_CHUNK);
+        if (begin >= s->queue_size) break;
+        long long end = begin + QUEUE_CHUNK < s->queue_size ? begin + QUEUE_CHUNK : s->queue_size;
+        for (long long f = begin; f < end; f++) {
+            int v = s->queue[f];
+            atomic_fetch_or_explicit(&s->front[v >> 6], 1ULL << (v & 63), memory_order_relaxed);
+        }
+    }
+}
+
+static void bitmapToQueue(BFSWorker *w) {
+    BFSShared *s = w->shared;
+    long long found = 0;
+
+    while (true) {
+        long long begin = atomic_fetch_add(&s->next_index, WORD_CHUNK);
+        if (begin >= s->num_words) break;
+        long long end = begin + WORD_CHUNK < s->num_words ? begin + WORD_CHUNK : s->num_words;
+        for (long long word = begin; word < end; word++) {
+            uint64_t bits = atomic_load_explicit(&s->front[word], memory_order_relaxed);
+            while (bits) {
+                int b = __builtin_ctzll(bits);
+                localPush(w, &found, (int)(word << 6) + b);
+                bits &= bits - 1;
+            }
+        }
+    }
+
+    flushLocal(w, found);
+}
+
+static void executePhase(BFSWorker *w) {
+    switch (w->shared->phase) {
+        case PHASE_TOP_DOWN:        topDownStep(w);   break;
+        case PHASE_BOTTOM_UP:       bottomUpStep(w);  break;
+        case PHASE_QUEUE_TO_BITMAP: queueToBitmap(w); break;
+        case PHASE_BITMAP_TO_QUEUE: bitmapToQueue(w); break;
+        case PHASE_DONE:            break;
+    }
+}
+
+static void* bfsWorker(void *arg) {
+    BFSWorker *w = (BFSWorker*)arg;
+    BFSShared *s = w->shared;
+
+    while (true) {
+        pthread_barrier_wait(&s->barrier);   // Thread 0 has set the phase
+        if (s->phase == PHASE_DONE) return NULL;
+        executePhase(w);
+        pthread_barrier_wait(&s->barrier);   // Phase complete
+    }
+}
+
+// Run one phase on all threads; the caller is worker 0
+static void runPhase(BFSWorker *self, BFSPhase phase) {
+    BFSShared *s = self->shared;
+    s->phase = phase;
+    atomic_store(&s->next_index, 0);
+    pthread_barrier_wait(&s->barrier);
+    executePhase(self);
+    pthread_barrier_wait(&s->barrier);
+}
+
+static void swapQueues(BFSShared *s) {
+    int *tmp = s->queue;
+    s->queue = s->next_queue;
+    s->next_queue = tmp;
+    s->queue_size = atomic_load(&s->next_tail);
+    atomic_store(&s->next_tail, 0);
+}
+
+long long parallelBFS(const CSRGraph *graph, int source, int num_threads,
+                      int *parent, BFSStats *stats) {
+    int n = graph->num_vertices;
+    if (num_threads < 1) num_threads = 1;
+
+    BFSShared s;
+    s.graph = graph;
+    s.parent = parent;
+    s.num_words = ((long long)n + 63) / 64;
+    s.visited = (_Atomic uint64_t*)calloc(s.num_words, sizeof(uint64_t));
+    s.front = (_Atomic uint64_t*)calloc(s.num_words, sizeof(uint64_t));
+    s.next = (_Atomic uint64_t*)calloc(s.num_words, sizeof(uint64_t));
+    s.queue = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    s.next_queue = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    atomic_init(&s.next_index, 0);
+    atomic_init(&s.next_tail, 0);
+    atomic_init(&s.scout_count, 0);
+    atomic_init(&s.awake_count, 0);
+    pthread_barrier_init(&s.barrier, NULL, num_threads);
+
+    for (int i = 0; i < n; i++) parent[i] = -1;
+    parent[source] = source;
+    atomic_store(&s.visited[source >> 6], 1ULL << (source & 63));
+    s.queue[0] = source;
+    s.queue_size = 1;
+
+    pthread_t *threads = (pthread_t*)malloc(num_threads * sizeof(pthread_t));
+    BFSWorker *workers = (BFSWorker*)calloc(num_threads, sizeof(BFSWorker));
+    for (int t = 0; t < num_threads; t++) {
+        workers[t].shared = &s;
+        workers[t].id = t;
+        if (t > 0) pthread_create(&threads[t], NULL, bfsWorker, &workers[t]);
+    }
+
+    BFSStats local_stats = {0, 0, 0, 1, csrDegree(graph, source)};
+    long long edges_to_check = graph->num_arcs;
+    long long scout_count = csrDegree(graph, source);
+    BFSWorker *self = &workers[0];
+
+    // Bottom-up needs in-neighbors == out-neighbors
+    bool can_bottom_up = !graph->directed;
+
+    while (s.queue_size > 0) {
+        if (can_bottom_up && scout_count > edges_to_check / BFS_ALPHA) {
+            // Switch to bottom-up until the frontier is small and shrinking
+            memset((void*)s.front, 0, s.num_words * sizeof(uint64_t));
+            runPhase(self, PHASE_QUEUE_TO_BITMAP);
+            long long awake = s.queue_size;
+            long long old_awake;
+            do {
+                old_awake = awake;
+                atomic_store(&s.awake_count, 0);
+                runPhase(self, PHASE_BOTTOM_UP);
+                awake = atomic_load(&s.awake_count);
+                _Atomic uint64_t *tmp = s.front;
+                s.front = s.next;
+                s.next = tmp;
+                local_stats.bottom_up_steps++;
+                local_stats.levels++;
+                local_stats.vertices_reached += awake;
+            } while (awake > 0 && (awake >= old_awake || awake > n / BFS_BETA));
+
+            runPhase(self, PHASE_BITMAP_TO_QUEUE);
+            swapQueues(&s);
+            scout_count = 1;
+        } else {
+            edges_to_check -= scout_count;
+            atomic_store(&s.scout_count, 0);
+            runPhase(self, PHASE_TOP_DOWN);
+            swapQueues(&s);
+            scout_count = atomic_load(&s.scout_count);
+            local_stats.top_down_steps++;
+            local_stats.levels++;
+            local_stats.vertices_reached += s.queue_size;
+        }
+    }
+
+    // Release the other workers
+    s.phase = PHASE_DONE;
+    pthread_barrier_wait(&s.barrier);
+    for (int t = 1; t < num_threads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    // The last step of each run found nothing; it is not a level
+    local_stats.levels--;
+    local_stats.edges_in_component = 0;
+    for (int v = 0; v < n; v++) {
+        if (parent[v] != -1) local_stats.edges_in_component += csrDegree(graph, v);
+    }
+    if (stats != NULL) *stats = local_stats;
+
+    for (int t = 0; t < num_threads; t++) free(workers[t].local_queue);
+    free(workers);
+    free(threads);
+    free((void*)s.visited);
+    free((void*)s.front);
+    free((void*)s.next);
+    free(s.queue);
+    free(s.next_queue);
+    pthread_barrier_destroy(&s.barrier);
+    return local_stats.vertices_reached;
+}
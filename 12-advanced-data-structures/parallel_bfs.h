@@ -0,0 +1,42 @@
+/*
+ * parallel_bfs.h
+ * Multi-threaded direction-optimizing BFS on a CSR graph
+ *
+ * Top-down steps expand the frontier queue edge by edge. When the
+ * frontier touches a large share of the remaining edges, bottom-up
+ * steps take over: every unvisited vertex scans its own neighbors for
+ * one that is in the frontier bitmap and stops at the first hit. On
+ * low-diameter graphs this skips most of the edges of the huge middle
+ * levels.
+ */
+
+#ifndef PARALLEL_BFS_H
+#define PARALLEL_BFS_H
+
+#include "csr_graph.h"
+
+// Switch to bottom-up when frontier edges > unexplored edges / ALPHA,
+// back to top-down when the frontier shrinks below n / BETA vertices
+#define BFS_ALPHA 15
+#define BFS_BETA 18
+
+typedef struct {
+    int levels;
+    int top_down_steps;
+    int bottom_up_steps;
+    long long vertices_reached;
+    long long edges_in_component;   // Sum of degrees of reached vertices
+} BFSStats;
+
+/**
+ * @brief Parallel direction-optimizing BFS
+ * @param parent Receives the BFS tree (num_vertices entries):
+ *               parent[source] == source, -1 for unreached vertices
+ * @param num_threads Worker threads (1 runs the same steps serially)
+ * @param stats Optional, may be NULL
+ * @return Number of vertices reached
+ */
+long long parallelBFS(const CSRGraph *graph, int source, int num_threads,
+                      int *parent, BFSStats *stats);
+
+#endif /* PARALLEL_BFS_H */
@@ -0,0 +1,62 @@
+/*
+ * parallel_for.c
+ * Dynamically scheduled parallel loop shared by the graph algorithms
+ * Topics: work distribution with an atomic counter, per-thread indices
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "parallel_for.h"
+
+typedef struct {
+    atomic_llong next;
+    long long count;
+    long long chunk;
+    ParallelBody body;
+    void *context;
+} ParallelLoop;
+
+typedef struct {
+    ParallelLoop *loop;
+    int thread;
+} LoopWorker;
+
+static void* parallelLoopWorker(void *arg) {
+    LoopWorker *w = (LoopWorker*)arg;
+    ParallelLoop *loop = w->loop;
+    while (true) {
+        long long begin = atomic_fetch_add(&loop->next, loop->chunk);
+        if (begin >= loop->count) break;
+        long long end = begin + loop->chunk < loop->count ? begin + loop->chunk : loop->count;
+        loop->body(loop->context, begin, end, w->thread);
+    }
+    return NULL;
+}
+
+void parallelFor(long long count, long long chunk, int num_threads, ParallelBody body,
+                 void *context) {
+    if (num_threads < 1) num_threads = 1;
+    ParallelLoop loop;
+    atomic_init(&loop.next, 0);
+    loop.count = count;
+    loop.chunk = chunk;
+    loop.body = body;
+    loop.context = context;
+
+    pthread_t *threads = (pthread_t*)malloc(num_threads * sizeof(pthread_t));
+    LoopWorker *workers = (LoopWorker*)malloc(num_threads * sizeof(LoopWorker));
+    for (int t = 0; t < num_threads; t++) {
+        workers[t] = (LoopWorker){ &loop, t };
+        if (t > 0) pthread_create(&threads[t], NULL, parallelLoopWorker, &workers[t]);
+    }
+    parallelLoopWorker(&workers[0]);
+    for (int t = 1; t < num_threads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+    free(workers);
+    free(threads);
+}
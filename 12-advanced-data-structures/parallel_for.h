@@ -0,0 +1,28 @@
+/*
+ * parallel_for.h
+ * Dynamically scheduled parallel loop shared by the graph algorithms
+ *
+ * Threads take chunks of the index range from a shared atomic counter,
+ * so skewed work (a few high-degree vertices) still balances: a thread
+ * that draws an expensive chunk simply takes fewer of them. The calling
+ * thread works too and the helpers are joined before returning.
+ */
+
+#ifndef PARALLEL_FOR_H
+#define PARALLEL_FOR_H
+
+/**
+ * @brief Loop body over [begin, end)
+ * @param thread Index of the running thread in 0 .. num_threads-1, for
+ *               per-thread scratch space
+ */
+typedef void (*ParallelBody)(void *context, long long begin, long long end, int thread);
+
+/**
+ * @brief Run body over [0, count) in chunks of chunk indices on
+ *        num_threads threads (at least one)
+ */
+void parallelFor(long long count, long long chunk, int num_threads, ParallelBody body,
+                 void *context);
+
+#endif /* PARALLEL_FOR_H */
@@ -0,0 +1,667 @@
+/*
+ * shortest_paths.c
+ * Weighted single-source shortest paths: Dijkstra (radix heap) and
+ * parallel delta-stepping
+ * Topics: monotone priority queues, bucketed relaxation, atomics,
+ *         barrier-synchronized worker threads
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "shortest_paths.h"
+
+static inline int arcWeight(const CSRGraph *graph, long long arc) {
+    return graph->weights != NULL ? graph->weights[arc] : 1;
+}
+
+static SSSPResult* createResult(int num_vertices, int source) {
+    SSSPResult *result = (SSSPResult*)malloc(sizeof(SSSPResult));
+    result->num_vertices = num_vertices;
+    result->source = source;
+    result->dist = (long long*)malloc(num_vertices * sizeof(long long));
+    result->parent = (int*)malloc(num_vertices * sizeof(int));
+    for (int i = 0; i < num_vertices; i++) {
+        result->dist[i] = SSSP_INF;
+        result->parent[i] = -1;
+    }
+    return result;
+}
+
+void freeSSSPResult(SSSPResult *result) {
+    if (result == NULL) return;
+    free(result->dist);
+    free(result->parent);
+    free(result);
+}
+
+int ssspPath(const SSSPResult *result, int target, int *path) {
+    if (result->dist[target] == SSSP_INF) return 0;
+
+    int path_len = 0;
+    for (int current = target; current != -1; current = result->parent[current]) {
+        path[path_len++] = current;
+        if (current == result->source || path_len == result->num_vertices) break;
+    }
+    for (int i = 0; i < path_len / 2; i++) {
+        int tmp = path[i];
+        path[i] = path[path_len - 1 - i];
+        path[path_len - 1 - i] = tmp;
+    }
+    return path_len;
+}
+
+// ===== Radix heap =====
+// Dijkstra extracts keys in non-decreasing order, so items can be
+// bucketed by the highest bit in which they differ from the last
+// extracted key. Each item moves down at most 64 times in total.
+
+#define RADIX_BUCKETS 65
+
+typedef struct {
+    long long key;
+    int vertex;
+} RadixItem;
+
+typedef struct {
+    RadixItem *items;
+    int size;
+    int capacity;
+} RadixBucket;
+
+typedef struct {
+    RadixBucket buckets[RADIX_BUCKETS];
+    long long last;
+    long long size;
+} RadixHeap;
+
+static inline int radixBucketIndex(const RadixHeap *heap, long long key) {
+    if (key == heap->last) return 0;
+    return 64 - __builtin_clzll((unsigned long long)(key ^ heap->last));
+}
+
+static void radixBucketAppend(RadixBucket *bucket, RadixItem item) {
+    if (bucket->size == bucket->capacity) {
+        bucket->capacity = bucket->capacity ? bucket->capacity * 2 : 16;
+        bucket->items = (RadixItem*)realloc(bucket->items,
+                                            bucket->capacity * sizeof(RadixItem));
+    }
+    bucket->items[bucket->size++] = item;
+}
+
+static void radixPush(RadixHeap *heap, long long key, int vertex) {
+    RadixItem item = { key, vertex };
+    radixBucketAppend(&heap->buckets[radixBucketIndex(heap, key)], item);
+    heap->size++;
+}
+
+static RadixItem radixPop(RadixHeap *heap) {
+    if (heap->buckets[0].size == 0) {
+        // Refill bucket 0 from the first non-empty bucket
+        int i = 1;
+        while (heap->buckets[i].size == 0) i++;
+
+        RadixBucket *bucket = &heap->buckets[i];
+        long long min_key = bucket->items[0].key;
+        for (int j = 1; j < bucket->size; j++) {
+            if (bucket->items[j].key < min_key) min_key = bucket->items[j].key;
+        }
+        heap->last = min_key;
+
+        // Every item lands in a bucket below i
+        for (int j = 0; j < bucket->size; j++) {
+            RadixItem item = bucket->items[j];
+            radixBucketAppend(&heap->buckets[radixBucketIndex(heap, item.key)], item);
+        }
+        bucket->size = 0;
+    }
+
+    heap->size--;
+    return heap->buckets[0].items[--heap->buckets[0].size];
+}
+
+SSSPResult* dijkstra(const CSRGraph *graph, int source) {
+    SSSPResult *result = createResult(graph->num_vertices, source);
+    long long *dist = result->dist;
+    RadixHeap heap;
+    memset(&heap, 0, sizeof(heap));
+
+    dist[source] = 0;
+    radixPush(&heap, 0, source);
+
+    while (heap.size > 0) {
+        RadixItem item = radixPop(&heap);
+        int vertex = item.vertex;
+        if (item.key > dist[vertex]) continue;  // Stale entry
+
+        for (long long i = graph->offsets[vertex]; i < graph->offsets[vertex + 1]; i++) {
+            int adj_vertex = graph->targets[i];
+            long long new_dist = item.key + arcWeight(graph, i);
+            if (new_dist < dist[adj_vertex]) {
+                dist[adj_vertex] = new_dist;
+                result->parent[adj_vertex] = vertex;
+                radixPush(&heap, new_dist, adj_vertex);
+            }
+        }
+    }
+
+    for (int i = 0; i < RADIX_BUCKETS; i++) {
+        free(heap.buckets[i].items);
+    }
+    return result;
+}
+
+// ===== Delta-stepping =====
+// Vertices with tentative distance in [b*delta, (b+1)*delta) sit in
+// bucket b. All threads relax the current bucket together; improved
+// vertices go into thread-local bins, and the smallest non-empty bin
+// across threads becomes the next frontier. Re-inserting into the
+// current bucket repeats it until it settles (the "light edge" phases).
+//
+// Relaxing bucket b only reaches buckets b .. b + ceil(max_weight/delta),
+// so each thread keeps that many bins plus one in a ring indexed by
+// bucket % num_bins: memory and the next-bucket scan depend on the
+// weights, not on the largest distance. A bitmap of non-empty bins lets
+// the scan skip 64 bins at a time.
+
+#define DELTA_CHUNK 64
+#define DELTA_MAX_BINS (1 << 16)    // delta is raised to stay within this
+#define NO_BIN LLONG_MAX
+
+typedef struct {
+    int *items;
+    long long size;
+    long long capacity;
+} VertexBin;
+
+typedef struct {
+    const CSRGraph *graph;
+    long long delta;
+    long long num_bins;             // Ring size, the same for every thread
+    int num_threads;
+    _Atomic long long *dist;
+
+    int *frontier;
+    long long frontier_size;
+    long long frontier_capacity;
+    long long cur_bin;
+
+    atomic_llong next_index;
+    atomic_llong next_bin;
+    atomic_llong gather_total;
+    pthread_barrier_t barrier;
+} DeltaShared;
+
+typedef struct {
+    DeltaShared *shared;
+    int id;
+    VertexBin *bins;                // Ring of shared->num_bins bins
+    uint64_t *nonempty;             // Bit per bin of the ring
+} DeltaWorker;
+
+// First set bit at index >= from, or -1
+static long long firstSetFrom(const uint64_t *bits, long long num_bits, long long from) {
+    long long num_words = (num_bits + 63) / 64;
+    long long w = from / 64;
+    if (w >= num_words) return -1;
+    uint64_t word = bits[w] & (~0ULL << (from % 64));
+    while (word == 0) {
+        if (++w >= num_words) return -1;
+        word = bits[w];
+    }
+    return w * 64 + __builtin_ctzll(word);
+}
+
+static void binPush(DeltaWorker *w, long long bin, int vertex) {
+    long long slot = bin % w->shared->num_bins;
+    VertexBin *b = &w->bins[slot];
+    w->nonempty[slot / 64] |= 1ULL << (slot % 64);
+    if (b->size == b->capacity) {
+        b->capacity = b->capacity ? b->capacity * 2 : 64;
+        b->items = (int*)realloc(b->items, b->capacity * sizeof(int));
+    }
+    b->items[b->size++] = vertex;
+}
+
+static void relaxFrontier(DeltaWorker *w) {
+    DeltaShared *s = w->shared;
+    const CSRGraph *graph = s->graph;
+    long long bin_start = s->cur_bin * s->delta;
+
+    while (true) {
+        long long begin = atomic_fetch_add(&s->next_index, DELTA_CHUNK);
+        if (begin >= s->frontier_size) break;
+        long long end = begin + DELTA_CHUNK < s->frontier_size ? begin + DELTA_CHUNK
+                                                               : s->frontier_size;
+        for (long long f = begin; f < end; f++) {
+            int vertex = s->frontier[f];
+            long long d = atomic_load_explicit(&s->dist[vertex], memory_order_relaxed);
+            if (d < bin_start) continue;  // Already settled in an earlier pass
+
+            for (long long i = graph->offsets[vertex]; i < graph->offsets[vertex + 1]; i++) {
+                int adj_vertex = graph->targets[i];
+                long long new_dist = d + arcWeight(graph, i);
+                long long old = atomic_load_explicit(&s->dist[adj_vertex], memory_order_relaxed);
+                while (new_dist < old) {
+                    if (atomic_compare_exchange_weak_explicit(&s->dist[adj_vertex], &old, new_dist,
+                                                              memory_order_relaxed,
+                                                              memory_order_relaxed)) {
+                        binPush(w, new_dist / s->delta, adj_vertex);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+}
+
+static void* deltaWorker(void *arg) {
+    DeltaWorker *w = (DeltaWorker*)arg;
+    DeltaShared *s = w->shared;
+
+    while (true) {
+        relaxFrontier(w);
+        pthread_barrier_wait(&s->barrier);
+
+        // Smallest non-empty local bin; bins below cur_bin are empty and
+        // the ring holds nothing beyond cur_bin + num_bins - 1
+        long long local_min = NO_BIN;
+        long long cur_slot = s->cur_bin % s->num_bins;
+        long long slot = firstSetFrom(w->nonempty, s->num_bins, cur_slot);
+        if (slot < 0) slot = firstSetFrom(w->nonempty, s->num_bins, 0);
+        if (slot >= 0) {
+            local_min = s->cur_bin + (slot - cur_slot + s->num_bins) % s->num_bins;
+        }
+        long long global_min = atomic_load(&s->next_bin);
+        while (local_min < global_min &&
+               !atomic_compare_exchange_weak(&s->next_bin, &global_min, local_min)) {
+        }
+        pthread_barrier_wait(&s->barrier);
+
+        long long next = atomic_load(&s->next_bin);
+        if (next == NO_BIN) break;
+
+        // Gather every thread's bin into the shared frontier
+        long long next_slot = next % s->num_bins;
+        VertexBin *bin = &w->bins[next_slot];
+        long long mine = bin->size;
+        long long offset = atomic_fetch_add(&s->gather_total, mine);
+        pthread_barrier_wait(&s->barrier);
+
+        if (w->id == 0) {
+            long long total = atomic_load(&s->gather_total);
+            if (total > s->frontier_capacity) {
+                s->frontier_capacity = total;
+                s->frontier = (int*)realloc(s->frontier, total * sizeof(int));
+            }
+            s->frontier_size = total;
+            s->cur_bin = next;
+            atomic_store(&s->gather_total, 0);
+            atomic_store(&s->next_index, 0);
+            atomic_store(&s->next_bin, NO_BIN);
+        }
+        pthread_barrier_wait(&s->barrier);
+
+        if (mine > 0) {
+            memcpy(s->frontier + offset, bin->items, mine * sizeof(int));
+            bin->size = 0;
+            w->nonempty[next_slot / 64] &= ~(1ULL << (next_slot % 64));
+        }
+        pthread_barrier_wait(&s->barrier);
+    }
+    return NULL;
+}
+
+// Pick parents from tight arcs (dist[u] + w == dist[v]) once distances
+// are final. A BFS from the source over tight arcs only gives a vertex a
+// parent that is already in the tree, so zero-weight cycles cannot form
+// parent cycles cut off from the source.
+static void assignParents(const CSRGraph *graph, SSSPResult *result) {
+    long long *dist = result->dist;
+    int *parent = result->parent;
+    int n = graph->num_vertices;
+    int *queue = (int*)malloc((n > 0 ? n : 1) * sizeof(int));
+    int head = 0, tail = 0;
+    queue[tail++] = result->source;
+
+    while (head < tail) {
+        int u = queue[head++];
+        for (long long i = graph->offsets[u]; i < graph->offsets[u + 1]; i++) {
+            int v = graph->targets[i];
+            if (v != result->source && parent[v] == -1 &&
+                dist[u] + arcWeight(graph, i) == dist[v]) {
+                parent[v] = u;
+                queue[tail++] = v;
+            }
+        }
+    }
+    free(queue);
+}
+
+SSSPResult* deltaStepping(const CSRGraph *graph, int source, long long delta,
+                          int num_threads) {
+    int n = graph->num_vertices;
+    if (delta < 1) delta = 1;
+    if (num_threads < 1) num_threads = 1;
+
+    long long max_weight = graph->num_arcs > 0 ? 1 : 0;
+    if (graph->weights != NULL) {
+        max_weight = 0;
+        for (long long i = 0; i < graph->num_arcs; i++) {
+            if (graph->weights[i] > max_weight) max_weight = graph->weights[i];
+        }
+    }
+    if ((max_weight + delta - 1) / delta + 1 > DELTA_MAX_BINS) {
+        delta = (max_weight + DELTA_MAX_BINS - 2) / (DELTA_MAX_BINS - 1);
+    }
+
+    DeltaShared shared;
+    shared.graph = graph;
+    shared.delta = delta;
+    shared.num_bins = (max_weight + delta - 1) / delta + 1;
+    shared.num_threads = num_threads;
+    shared.dist = (_Atomic long long*)malloc(n * sizeof(_Atomic long long));
+    for (int i = 0; i < n; i++) atomic_init(&shared.dist[i], SSSP_INF);
+    atomic_store(&shared.dist[source], 0);
+
+    shared.frontier_capacity = n > 0 ? n : 1;
+    shared.frontier = (int*)malloc(shared.frontier_capacity * sizeof(int));
+    shared.frontier[0] = source;
+    shared.frontier_size = 1;
+    shared.cur_bin = 0;
+    atomic_init(&shared.next_index, 0);
+    atomic_init(&shared.next_bin, NO_BIN);
+    atomic_init(&shared.gather_total, 0);
+    pthread_barrier_init(&shared.barrier, NULL, num_threads);
+
+    pthread_t *threads = (pthread_t*)malloc(num_threads * sizeof(pthread_t));
+    DeltaWorker *workers = (DeltaWorker*)calloc(num_threads, sizeof(DeltaWorker));
+    for (int t = 0; t < num_threads; t++) {
+        workers[t].shared = &shared;
+        workers[t].id = t;
+        workers[t].bins = (VertexBin*)calloc(shared.num_bins, sizeof(VertexBin));
+        workers[t].nonempty = (uint64_t*)calloc((shared.num_bins + 63) / 64, sizeof(uint64_t));
+        if (t > 0) pthread_create(&threads[t], NULL, deltaWorker, &workers[t]);
+    }
+    deltaWorker(&workers[0]);
+    for (int t = 1; t < num_threads; t++) {
+        pthread_join(threads[t], NULL);
+    }
+
+    SSSPResult *result = createResult(n, source);
+    for (int i = 0; i < n; i++) {
+        result->dist[i] = atomic_load_explicit(&shared.dist[i], memory_order_relaxed);
+    }
+    assignParents(graph, result);
+
+    for (int t = 0; t < num_threads; t++) {
+        for (long long b = 0; b < shared.num_bins; b++) {
+            free(workers[t].bins[b].items);
+        }
+        free(workers[t].bins);
+        free(workers[t].nonempty);
+    }
+    free(workers);
+    free(threads);
+    free(shared.frontier);
+    free(shared.dist);
+    pthread_barrier_destroy(&shared.barrier);
+    return result;
+}
+
+// ===== Point-to-point queries =====
+// Side 0 searches forward from the source, side 1 backward from the
+// target over reversed arcs. A vertex's dist/parent entries on a side
+// are only meaningful while its stamp equals the current epoch.
+
+struct PathQuery {
+    const CSRGraph *graph;
+    CSRGraph *reversed;             // NULL for undirected graphs
+    unsigned int epoch;
+    unsigned int *stamp[2];
+    long long *dist[2];
+    int *parent[2];
+    int *queue[2];                  // BFS frontiers
+    RadixHeap heap[2];
+    long long settled;
+};
+
+PathQuery* createPathQuery(const CSRGraph *graph) {
+    int n = graph->num_vertices;
+    size_t slots = n > 0 ? (size_t)n : 1;
+    PathQuery *query = (PathQuery*)calloc(1, sizeof(PathQuery));
+    query->graph = graph;
+
+    if (graph->directed) {
+        Edge *edges = (Edge*)malloc((graph->num_arcs > 0 ? graph->num_arcs : 1) * sizeof(Edge));
+        for (int u = 0; u < n; u++) {
+            for (long long i = graph->offsets[u]; i < graph->offsets[u + 1]; i++) {
+                edges[i] = (Edge){ graph->targets[i], u, arcWeight(graph, i) };
+            }
+        }
+        query->reversed = csrBuild(n, edges, graph->num_arcs, CSR_DIRECTED | CSR_WEIGHTED);
+        free(edges);
+    }
+
+    for (int side = 0; side < 2; side++) {
+        query->stamp[side] = (unsigned int*)calloc(slots, sizeof(unsigned int));
+        query->dist[side] = (long long*)malloc(slots * sizeof(long long));
+        query->parent[side] = (int*)malloc(slots * sizeof(int));
+        query->queue[side] = (int*)malloc(slots * sizeof(int));
+    }
+    return query;
+}
+
+void freePathQuery(PathQuery *query) {
+    if (query == NULL) return;
+    csrFree(query->reversed);
+    for (int side = 0; side < 2; side++) {
+        free(query->stamp[side]);
+        free(query->dist[side]);
+        free(query->parent[side]);
+        free(query->queue[side]);
+        for (int i = 0; i < RADIX_BUCKETS; i++) {
+            free(query->heap[side].buckets[i].items);
+        }
+    }
+    free(query);
+}
+
+long long pathQuerySettled(const PathQuery *query) {
+    return query->settled;
+}
+
+// Start a query: bump the epoch and empty the heaps (keeping capacity)
+static void beginQuery(PathQuery *query) {
+    if (++query->epoch == 0) {
+        // Wrapped around: stale stamps could look current, clear once
+        for (int side = 0; side < 2; side++) {
+            memset(query->stamp[side], 0, query->graph->num_vertices * sizeof(unsigned int));
+        }
+        query->epoch = 1;
+    }
+    for (int side = 0; side < 2; side++) {
+        RadixHeap *heap = &query->heap[side];
+        for (int i = 0; i < RADIX_BUCKETS; i++) heap->buckets[i].size = 0;
+        heap->last = 0;
+        heap->size = 0;
+    }
+    query->settled = 0;
+}
+
+static inline long long queryDist(const PathQuery *query, int side, int vertex) {
+    return query->stamp[side][vertex] == query->epoch ? query->dist[side][vertex] : SSSP_INF;
+}
+
+static inline void querySet(PathQuery *query, int side, int vertex, long long dist, int parent) {
+    query->stamp[side][vertex] = query->epoch;
+    query->dist[side][vertex] = dist;
+    query->parent[side][vertex] = parent;
+}
+
+// Arcs searched by a side: forward arcs, or reversed ones going backward
+static inline const CSRGraph* sideGraph(const PathQuery *query, int side) {
+    return side == 1 && query->reversed != NULL ? query->reversed : query->graph;
+}
+
+// Source..meet from forward parents, then meet..target from backward ones
+static int joinPath(const PathQuery *query, int meet, int *path) {
+    int len = 0;
+    for (int v = meet; v != -1; v = query->parent[0][v]) {
+        if (path != NULL) path[len] = v;
+        len++;
+    }
+    for (int i = 0; path != NULL && i < len / 2; i++) {
+        int tmp = path[i];
+        path[i] = path[len - 1 - i];
+        path[len - 1 - i] = tmp;
+    }
+    if (query->stamp[1][meet] == query->epoch) {
+        for (int v = query->parent[1][meet]; v != -1; v = query->parent[1][v]) {
+            if (path != NULL) path[len] = v;
+            len++;
+        }
+    }
+    return len;
+}
+
+long long bidirectionalBFS(PathQuery *query, int source, int target,
+                           int *path, int *path_len) {
+    beginQuery(query);
+    querySet(query, 0, source, 0, -1);
+    querySet(query, 1, target, 0, -1);
+
+    int size[2] = { 1, 1 };
+    int depth[2] = { 0, 0 };
+    query->queue[0][0] = source;
+    query->queue[1][0] = target;
+    long long best = source == target ? 0 : SSSP_INF;
+    int meet = source == target ? source : -1;
+
+    while (best == SSSP_INF && size[0] > 0 && size[1] > 0) {
+        // Expand one whole level of the smaller frontier
+        int side = size[0] <= size[1] ? 0 : 1;
+        const CSRGraph *graph = sideGraph(query, side);
+        int *frontier = query->queue[side];
+        int count = size[side];
+        int next = 0;
+        depth[side]++;
+
+        // New vertices are appended after the current level, then moved down
+        for (int f = 0; f < count; f++) {
+            int u = frontier[f];
+            query->settled++;
+            for (long long i = graph->offsets[u]; i < graph->offsets[u + 1]; i++) {
+                int v = graph->targets[i];
+                if (queryDist(query, side, v) != SSSP_INF) continue;
+                querySet(query, side, v, depth[side], u);
+                frontier[count + next++] = v;
+
+                long long other = queryDist(query, 1 - side, v);
+                if (other != SSSP_INF && depth[side] + other < best) {
+                    best = depth[side] + other;
+                    meet = v;
+                }
+            }
+        }
+        memmove(frontier, frontier + count, next * sizeof(int));
+        size[side] = next;
+    }
+
+    int len = best != SSSP_INF ? joinPath(query, meet, path) : 0;
+    if (path_len != NULL) *path_len = len;
+    return best;
+}
+
+long long bidirectionalDijkstra(PathQuery *query, int source, int target,
+                                int *path, int *path_len) {
+    beginQuery(query);
+    querySet(query, 0, source, 0, -1);
+    querySet(query, 1, target, 0, -1);
+    radixPush(&query->heap[0], 0, source);
+    radixPush(&query->heap[1], 0, target);
+
+    long long best = source == target ? 0 : SSSP_INF;
+    int meet = source == target ? source : -1;
+    long long radius[2] = { 0, 0 };     // Last key popped on each side
+
+    while (query->heap[0].size > 0 && query->heap[1].size > 0) {
+        int side = query->heap[0].size <= query->heap[1].size ? 0 : 1;
+        RadixItem item = radixPop(&query->heap[side]);
+        radius[side] = item.key;
+
+        // Every unexplored path is at least as long as the two radii
+        if (best != SSSP_INF && radius[0] + radius[1] >= best) break;
+        if (item.key > queryDist(query, side, item.vertex)) continue;  // Stale entry
+        query->settled++;
+
+        const CSRGraph *graph = sideGraph(query, side);
+        int u = item.vertex;
+        for (long long i = graph->offsets[u]; i < graph->offsets[u + 1]; i++) {
+            int v = graph->targets[i];
+            long long new_dist = item.key + arcWeight(graph, i);
+            if (new_dist < queryDist(query, side, v)) {
+                querySet(query, side, v, new_dist, u);
+                radixPush(&query->heap[side], new_dist, v);
+
+                long long other = queryDist(query, 1 - side, v);
+                if (other != SSSP_INF && new_dist + other < best) {
+                    best = new_dist + other;
+                    meet = v;
+                }
+            }
+        }
+    }
+
+    int len = best != SSSP_INF ? joinPath(query, meet, path) : 0;
+    if (path_len != NULL) *path_len = len;
+    return best;
+}
+
+long long aStarSearch(PathQuery *query, int source, int target,
+                      AStarHeuristic heuristic, void *context,
+                      int *path, int *path_len) {
+    const CSRGraph *graph = query->graph;
+    beginQuery(query);
+    querySet(query, 0, source, 0, -1);
+    radixPush(&query->heap[0], heuristic ? heuristic(source, target, context) : 0, source);
+
+    long long best = SSSP_INF;
+    while (query->heap[0].size > 0) {
+        RadixItem item = radixPop(&query->heap[0]);
+        int u = item.vertex;
+        long long g = queryDist(query, 0, u);
+        long long h = heuristic ? heuristic(u, target, context) : 0;
+        if (item.key > g + h) continue;     // Stale entry
+        query->settled++;
+        if (u == target) {
+            best = g;
+            break;
+        }
+
+        for (long long i = graph->offsets[u]; i < graph->offsets[u + 1]; i++) {
+            int v = graph->targets[i];
+            long long new_dist = g + arcWeight(graph, i);
+            if (new_dist < queryDist(query, 0, v)) {
+                querySet(query, 0, v, new_dist, u);
+                long long key = new_dist + (heuristic ? heuristic(v, target, context) : 0);
+                radixPush(&query->heap[0], key, v);
+            }
+        }
+    }
+
+    int len = best != SSSP_INF ? joinPath(query, target, path) : 0;
+    if (path_len != NULL) *path_len = len;
+    return best;
+}
+
+long long gridHeuristic(int vertex, int target, void *context) {
+    const GridLayout *grid = (const GridLayout*)context;
+    int dr = vertex / grid->width - target / grid->width;
+    int dc = vertex % grid->width - target % grid->width;
+    return (long long)((dr < 0 ? -dr : dr) + (dc < 0 ? -dc : dc)) * grid->min_weight;
+}
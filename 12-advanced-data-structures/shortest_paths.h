@@ -0,0 +1,131 @@
+/*
+ * shortest_paths.h
+ * Weighted single-source shortest paths on a CSR graph
+ *
+ * dijkstra()      - sequential, monotone radix heap as priority queue
+ * deltaStepping() - parallel, vertices grouped in buckets of width delta
+ *
+ * Point-to-point queries go through a PathQuery, which owns scratch
+ * arrays sized for the graph. Marks are stamped with a per-query epoch,
+ * so starting a query costs O(1) instead of clearing n entries:
+ *
+ * bidirectionalBFS()      - hop distance, searching from both ends
+ * bidirectionalDijkstra() - weighted distance, searching from both ends
+ * aStarSearch()           - weighted distance guided by a heuristic
+ *
+ * Edge weights come from graph->weights (1 for every edge when the
+ * graph was built without CSR_WEIGHTED) and must be non-negative.
+ */
+
+#ifndef SHORTEST_PATHS_H
+#define SHORTEST_PATHS_H
+
+#include <limits.h>
+#include "csr_graph.h"
+
+#define SSSP_INF LLONG_MAX
+
+typedef struct {
+    int num_vertices;
+    int source;
+    long long *dist;    // SSSP_INF for unreachable vertices
+    int *parent;        // -1 for the source and unreachable vertices
+} SSSPResult;
+
+/**
+ * @brief Dijkstra's algorithm with a radix heap
+ * @return Distances and parents from source (free with freeSSSPResult)
+ */
+SSSPResult* dijkstra(const CSRGraph *graph, int source);
+
+/**
+ * @brief Parallel delta-stepping
+ * @param delta Bucket width; about the average edge weight is a good start.
+ *              Raised if needed so that max weight / delta stays below
+ *              65536 (each thread keeps that many buckets)
+ * @param num_threads Worker threads (1 runs the same algorithm serially)
+ * @return Distances and parents from source (free with freeSSSPResult)
+ *
+ * Parents are chosen after distances converge, by a search from the
+ * source over arcs with dist[u] + w == dist[v], so every reachable
+ * vertex's parent chain leads back to the source. With zero-weight or
+ * tied paths the tree may differ from dijkstra()'s.
+ */
+SSSPResult* deltaStepping(const CSRGraph *graph, int source, long long delta,
+                          int num_threads);
+
+/**
+ * @brief Reconstruct the path source..target
+ * @param path Receives the vertices (room for num_vertices)
+ * @return Number of vertices on the path, or 0 if target is unreachable
+ */
+int ssspPath(const SSSPResult *result, int target, int *path);
+
+void freeSSSPResult(SSSPResult *result);
+
+// ===== Point-to-point queries =====
+
+typedef struct PathQuery PathQuery;
+
+/**
+ * @brief Lower bound on the distance from vertex to target
+ *
+ * Must be consistent: h(target) == 0 and h(u) <= w(u, v) + h(v) for
+ * every arc, which keeps A* keys non-decreasing.
+ */
+typedef long long (*AStarHeuristic)(int vertex, int target, void *context);
+
+/**
+ * @brief Scratch state for repeated queries on one graph
+ *
+ * Directed graphs get a reversed copy of their arcs for the backward
+ * search; the graph must outlive the query object.
+ */
+PathQuery* createPathQuery(const CSRGraph *graph);
+void freePathQuery(PathQuery *query);
+
+/**
+ * @brief Bidirectional BFS: expand the smaller frontier one level at a time
+ * @param path If not NULL, receives source..target (room for num_vertices)
+ * @param path_len If not NULL, receives the number of vertices on the path
+ * @return Number of edges on a shortest path, or SSSP_INF
+ */
+long long bidirectionalBFS(PathQuery *query, int source, int target,
+                           int *path, int *path_len);
+
+/**
+ * @brief Bidirectional Dijkstra; stops once the two search radii
+ *        together reach the best path found so far
+ * @return Weighted distance, or SSSP_INF (path and path_len as above)
+ */
+long long bidirectionalDijkstra(PathQuery *query, int source, int target,
+                                int *path, int *path_len);
+
+/**
+ * @brief A* search; stops when target is settled
+ * @param heuristic Consistent lower bound (NULL behaves like Dijkstra)
+ * @return Weighted distance, or SSSP_INF (path and path_len as above)
+ */
+long long aStarSearch(PathQuery *query, int source, int target,
+                      AStarHeuristic heuristic, void *context,
+                      int *path, int *path_len);
+
+/**
+ * @brief Vertices settled (BFS: dequeued) by the last query
+ */
+long long pathQuerySettled(const PathQuery *query);
+
+/**
+ * @brief Grid layout for gridHeuristic: vertex = row * width + column
+ */
+typedef struct {
+    int width;
+    int min_weight;         // Smallest edge weight in the grid
+} GridLayout;
+
+/**
+ * @brief Manhattan distance times the smallest weight (context: GridLayout*)
+ */
+long long gridHeuristic(int vertex, int target, void *context);
+
+#endif /* SHORTEST_PATHS_H */
@@ -0,0 +1,308 @@
+/*
+ * topk_stream.c
+ * Streaming top-k selection over unbounded input
+ * Topics: bounded min-heap, SIMD threshold pre-filter, merging
+ *         per-thread results
+ *
+ * Keeping the k best records only needs a min-heap of size k: its root
+ * is the current k-th best score (the "threshold"). Anything not above
+ * the threshold can never enter the result, so most of a long stream is
+ * rejected by a single comparison. The batch API compares 4 scores at a
+ * time with SSE2 and only touches the heap when at least one of them
+ * beats the threshold.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <pthread.h>
+#include <time.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+typedef struct {
+    float score;
+    long long id;
+} Record;
+
+typedef struct {
+    Record *data;       // Min-heap ordered by score, data[0] is the k-th best
+    int size;
+    int k;
+    long long seen;     // Total records offered
+    long long touched;  // Records that reached the heap
+} TopK;
+
+static double nowSeconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Create an empty top-k selector; NULL unless k >= 1
+TopK* createTopK(int k) {
+    if (k < 1) return NULL;
+    TopK *t = (TopK*)malloc(sizeof(TopK));
+    t->data = (Record*)malloc(k * sizeof(Record));
+    t->size = 0;
+    t->k = k;
+    t->seen = 0;
+    t->touched = 0;
+    return t;
+}
+
+void freeTopK(TopK *t) {
+    if (t == NULL) return;
+    free(t->data);
+    free(t);
+}
+
+static void siftUp(Record *heap, int index) {
+    Record item = heap[index];
+    while (index > 0) {
+        int parent_idx = (index - 1) / 2;
+        if (heap[parent_idx].score <= item.score) break;
+        heap[index] = heap[parent_idx];
+        index = parent_idx;
+    }
+    heap[index] = item;
+}
+
+static void siftDown(Record *heap, int size, int index) {
+    Record item = heap[index];
+    while (true) {
+        int child = 2 * index + 1;
+        if (child >= size) break;
+        if (child + 1 < size && heap[child + 1].score < heap[child].score) child++;
+        if (item.score <= heap[child].score) break;
+        heap[index] = heap[child];
+        index = child;
+    }
+    heap[index] = item;
+}
+
+// Lowest score that would still be rejected (-inf until the heap fills)
+static inline float topkThreshold(const TopK *t) {
+    return t->size < t->k ? -__builtin_inff() : t->data[0].score;
+}
+
+// Offer a record that already beat the threshold
+static inline void topkAccept(TopK *t, Record r) {
+    t->touched++;
+    if (t->size < t->k) {
+        t->data[t->size] = r;
+        siftUp(t->data, t->size++);
+    } else {
+        t->data[0] = r;
+        siftDown(t->data, t->size, 0);
+    }
+}
+
+// Offer one record
+void topkPush(TopK *t, Record r) {
+    t->seen++;
+    if (r.score > topkThreshold(t)) {
+        topkAccept(t, r);
+    }
+}
+
+// Offer n consecutive scores; record i gets id first_id + i
+void topkPushBatch(TopK *t, const float *scores, long long first_id, size_t n) {
+    size_t i = 0;
+    t->seen += (long long)n;
+
+    // Fill phase: nothing can be rejected until k records are held
+    for (; i < n && t->size < t->k; i++) {
+        Record r = { scores[i], first_id + (long long)i };
+        topkAccept(t, r);
+    }
+
+#ifdef __SSE2__
+    __m128 threshold = _mm_set1_ps(topkThreshold(t));
+    for (; i + 4 <= n; i += 4) {
+        __m128 v = _mm_loadu_ps(scores + i);
+        int mask = _mm_movemask_ps(_mm_cmpgt_ps(v, threshold));
+        if (mask == 0) continue;
+
+        // Rare path: re-check each lane against the (rising) threshold
+        for (int lane = 0; lane < 4; lane++) {
+            if ((mask >> lane & 1) && scores[i + lane] > t->data[0].score) {
+                Record r = { scores[i + lane], first_id + (long long)(i + lane) };
+                topkAccept(t, r);
+            }
+        }
+        threshold = _mm_set1_ps(t->data[0].score);
+    }
+#endif
+
+    float limit = topkThreshold(t);
+    for (; i < n; i++) {
+        if (scores[i] > limit) {
+            Record r = { scores[i], first_id + (long long)i };
+            topkAccept(t, r);
+            limit = topkThreshold(t);
+        }
+    }
+}
+
+// Fold src into dst (e.g. combine per-thread selectors)
+void topkMerge(TopK *dst, const TopK *src) {
+    long long seen = dst->seen + src->seen;
+    for (int i = 0; i < src->size; i++) {
+        topkPush(dst, src->data[i]);
+    }
+    dst->seen = seen;
+}
+
+// Copy the result into out[] sorted by descending score; returns count
+int topkResult(const TopK *t, Record *out) {
+    Record *heap = (Record*)malloc(t->size * sizeof(Record));
+    memcpy(heap, t->data, t->size * sizeof(Record));
+    int size = t->size;
+    for (int i = size - 1; i >= 0; i--) {
+        out[i] = heap[0];
+        heap[0] = heap[--size];
+        if (size > 0) siftDown(heap, size, 0);
+    }
+    free(heap);
+    return t->size;
+}
+
+// ===== Demo stream =====
+
+// Deterministic score generator so any chunk can be regenerated
+static inline float streamScore(uint64_t id) {
+    uint64_t x = id * 0x9E3779B97F4A7C15ull;
+    x ^= x >> 31;
+    x *= 0xBF58476D1CE4E5B9ull;
+    x ^= x >> 29;
+    return (float)(x >> 40) / (float)(1 << 24);
+}
+
+static void fillChunk(float *chunk, long long first_id, size_t n) {
+    for (size_t i = 0; i < n; i++) {
+        chunk[i] = streamScore((uint64_t)(first_id + (long long)i));
+    }
+}
+
+typedef struct {
+    TopK *topk;
+    long long begin;
+    long long end;
+} StreamSlice;
+
+static void* consumeSlice(void *arg) {
+    StreamSlice *s = (StreamSlice*)arg;
+    enum { CHUNK = 1 << 16 };
+    float *chunk = (float*)malloc(CHUNK * sizeof(float));
+    for (long long pos = s->begin; pos < s->end; pos += CHUNK) {
+        size_t n = (size_t)(s->end - pos < CHUNK ? s->end - pos : CHUNK);
+        fillChunk(chunk, pos, n);
+        topkPushBatch(s->topk, chunk, pos, n);
+    }
+    free(chunk);
+    return NULL;
+}
+
+static int compareDescending(const void *a, const void *b) {
+    float x = *(const float*)a, y = *(const float*)b;
+    return (x < y) - (x > y);
+}
+
+int main(int argc, char *argv[]) {
+    printf("=== Streaming Top-K Selection ===\n\n");
+
+    long long stream_len = argc > 1 ? atoll(argv[1]) : 50000000LL;
+    int k = argc > 2 ? atoi(argv[2]) : 1000;
+    int num_threads = argc > 3 ? atoi(argv[3]) : 4;
+    if (num_threads < 1) num_threads = 1;
+    if (k < 1) {
+        printf("k must be at least 1\n");
+        printf("Usage: ./topk_stream [stream_length] [k] [threads]\n");
+        return 1;
+    }
+
+    // Small example
+    printf("1. Top 3 of a short stream:\n");
+    float small[] = {4.0f, 9.5f, 1.0f, 7.25f, 3.0f, 8.0f, 2.0f, 6.5f, 9.0f};
+    TopK *t3 = createTopK(3);
+    topkPushBatch(t3, small, 0, 9);
+    Record top3[3];
+    int n3 = topkResult(t3, top3);
+    printf("   Stream: 4.0 9.5 1.0 7.25 3.0 8.0 2.0 6.5 9.0\n   Top 3: ");
+    for (int i = 0; i < n3; i++) printf("%.2f(id %lld) ", top3[i].score, top3[i].id);
+    printf("\n\n");
+    freeTopK(t3);
+
+    // Correctness against a full sort
+    printf("2. Verify against full sort (1M records, k=%d):\n", k);
+    int verify_n = 1000000;
+    float *all = (float*)malloc(verify_n * sizeof(float));
+    fillChunk(all, 0, verify_n);
+    TopK *check = createTopK(k);
+    topkPushBatch(check, all, 0, verify_n);
+    Record *result = (Record*)malloc(k * sizeof(Record));
+    int got = topkResult(check, result);
+    qsort(all, verify_n, sizeof(float), compareDescending);
+    bool ok = got == k;
+    for (int i = 0; ok && i < k; i++) ok = result[i].score == all[i];
+    printf("   Top-k matches sorted prefix: %s\n\n", ok ? "Yes" : "No");
+    free(all);
+    freeTopK(check);
+
+    // Single-threaded streaming throughput
+    printf("3. Stream %lld records, k=%d, single thread:\n", stream_len, k);
+    TopK *single = createTopK(k);
+    StreamSlice whole = { single, 0, stream_len };
+    double start = nowSeconds();
+    consumeSlice(&whole);
+    double elapsed = nowSeconds() - start;
+    printf("   Time: %.3f s (%.1f M records/s, includes generating the data)\n",
+           elapsed, stream_len / elapsed / 1e6);
+    printf("   Records that touched the heap: %lld (%.4f%%)\n\n",
+           single->touched, 100.0 * single->touched / single->seen);
+
+    // Per-thread selectors merged at the end
+    printf("4. Same stream split over %d threads, then merged:\n", num_threads);
+    pthread_t *threads = (pthread_t*)malloc(num_threads * sizeof(pthread_t));
+    StreamSlice *slices = (StreamSlice*)malloc(num_threads * sizeof(StreamSlice));
+    start = nowSeconds();
+    for (int i = 0; i < num_threads; i++) {
+        slices[i].topk = createTopK(k);
+        slices[i].begin = stream_len * i / num_threads;
+        slices[i].end = stream_len * (i + 1) / num_threads;
+        pthread_create(&threads[i], NULL, consumeSlice, &slices[i]);
+    }
+    TopK *merged = createTopK(k);
+    for (int i = 0; i < num_threads; i++) {
+        pthread_join(threads[i], NULL);
+        topkMerge(merged, slices[i].topk);
+        freeTopK(slices[i].topk);
+    }
+    elapsed = nowSeconds() - start;
+
+    Record *single_result = (Record*)malloc(k * sizeof(Record));
+    int a = topkResult(single, single_result);
+    int b = topkResult(merged, result);
+    ok = a == b;
+    for (int i = 0; ok && i < a; i++) ok = single_result[i].score == result[i].score;
+    printf("   Time: %.3f s, merged result equals single-thread result: %s\n",
+           elapsed, ok ? "Yes" : "No");
+    printf("   Best record: score %.6f, id %lld\n", result[0].score, result[0].id);
+
+    free(single_result);
+    free(result);
+    free(threads);
+    free(slices);
+    freeTopK(single);
+    freeTopK(merged);
+
+    printf("\n   Usage: ./topk_stream [stream_length] [k] [threads]\n");
+    return 0;
+}
@@ -0,0 +1,49 @@
+/*
+ * triangle_counting.h
+ * Triangle counting and clustering coefficients on undirected CSR graphs
+ *
+ * Each edge is oriented from the lower to the higher vertex in degree
+ * order, so every triangle is found exactly once (at its lowest vertex)
+ * and no vertex keeps more than O(sqrt(m)) out-neighbors, even the hubs
+ * of a power-law graph. The triangles on arc u -> v are the common
+ * out-neighbors of u and v: an intersection of two sorted lists.
+ *
+ * intersectSorted() - merge 4x4 blocks with SSE2 compares when the
+ *                     lists are of similar length; gallop through the
+ *                     longer one when they are not
+ * countTriangles()  - the parallel counter (self loops and duplicate
+ *                     edges are ignored)
+ */
+
+#ifndef TRIANGLE_COUNTING_H
+#define TRIANGLE_COUNTING_H
+
+#include "csr_graph.h"
+
+// Above this length ratio, intersectSorted gallops
+#define TRIANGLE_GALLOP_RATIO 32
+
+/**
+ * @brief Intersect two strictly increasing lists
+ * @param out If not NULL, receives the common elements in order
+ *            (room for the shorter length)
+ * @return Number of common elements
+ */
+long long intersectSorted(const int *a, long long len_a, const int *b, long long len_b, int *out);
+
+/**
+ * @brief Count triangles in parallel
+ * @param per_vertex If not NULL, receives the triangles through each
+ *                   vertex (num_vertices entries)
+ * @return Number of triangles
+ */
+long long countTriangles(const CSRGraph *graph, int num_threads, long long *per_vertex);
+
+/**
+ * @brief Local clustering coefficient: closed over possible triangles
+ * @param per_vertex Per-vertex triangles from countTriangles
+ * @return 2 t(v) / (d(v) (d(v) - 1)), or 0 below degree 2
+ */
+double clusteringCoefficient(const CSRGraph *graph, const long long *per_vertex, int vertex);
+
+#endif /* TRIANGLE_COUNTING_H */